@@ -0,0 +1,379 @@
+// Micro-benchmarks for the containers, Result, number formatting and the platform calculators.
+//
+// Every case reports nanoseconds and heap allocations per operation. The
+// default output is a table; --csv prints "name,n,ns_per_op,allocs_per_op"
+// lines for regression tracking, --filter <text> runs only the cases whose
+// name contains text.
+//
+// Build: cmake -S . -B build && cmake --build build --target vislib_bench
+
+#include "vislib.hpp"
+
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static unsigned long long allocationCount = 0;
+
+void* operator new(std::size_t size) {
+    allocationCount++;
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    allocationCount++;
+    return malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size) {
+    allocationCount++;
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    allocationCount++;
+    return malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { free(ptr); }
+void operator delete[](void* ptr) noexcept { free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { free(ptr); }
+
+namespace util = vislib::util;
+namespace motor = vislib::motor;
+namespace platform = vislib::platform;
+namespace calculators = vislib::platform::calculators;
+
+static volatile double sink = 0;
+static bool csv = false;
+static const char* filter = nullptr;
+
+template <typename Body> static void run(const char* name, unsigned long long n, unsigned long long iterations, Body&& body) {
+    if (filter != nullptr && strstr(name, filter) == nullptr) return;
+
+    for (unsigned long long it = 0; it < iterations / 16 + 1; it++) body(it);
+
+    unsigned long long before = allocationCount;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long long it = 0; it < iterations; it++) body(it);
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+    double allocs = static_cast<double>(allocationCount - before) / static_cast<double>(iterations);
+
+    if (csv) {
+        printf("%s,%llu,%.2f,%.2f\n", name, n, ns, allocs);
+    } else {
+        printf("%-48s %8llu %12.2f %14.2f\n", name, n, ns, allocs);
+    }
+}
+
+class MockMotor : public motor::controllers::RangedSpeedController {
+protected:
+    motor::Speed raw = 0;
+
+    util::Error setSpeedRaw(motor::Speed speed) noexcept override {
+        raw = speed;
+        return util::Error();
+    }
+
+    util::Result<motor::Speed> getSpeedRaw() const noexcept override {
+        return raw;
+    }
+
+public:
+    using motor::controllers::RangedSpeedController::RangedSpeedController;
+
+    util::Error init(int) noexcept {
+        return util::Error();
+    }
+};
+
+class CrtpMockMotor : public motor::controllers::RangedSpeedControllerBase<CrtpMockMotor> {
+protected:
+    motor::Speed raw = 0;
+
+public:
+    using motor::controllers::RangedSpeedControllerBase<CrtpMockMotor>::RangedSpeedControllerBase;
+
+    util::Error setSpeedRaw(motor::Speed speed) noexcept {
+        raw = speed;
+        return util::Error();
+    }
+
+    util::Result<motor::Speed> getSpeedRaw() const noexcept {
+        return raw;
+    }
+
+    util::Error init(int) noexcept {
+        return util::Error();
+    }
+};
+
+static platform::PlatformMotorConfig makeConfig(size_t count) {
+    platform::PlatformMotorConfig config(count);
+    for (size_t i = 0; i < count; i++) {
+        config[i] = motor::MotorInfo(static_cast<double>((i * 37) % 360), 0.05, 0.2, motor::SpeedRange(-255, 255), motor::SpeedRange(-1, 1));
+    }
+    return config;
+}
+
+static void containers() {
+    const size_t sizes[] = {4, 64, 1024};
+    for (size_t size : sizes) {
+        util::Array<double> source(size);
+        for (size_t i = 0; i < size; i++) source[i] = 0.5 * static_cast<double>(i);
+
+        run("array/copy", size, 200000, [&](unsigned long long it) {
+            util::Array<double> copy(source);
+            sink = sink + copy[it % size];
+        });
+
+        run("array/concat", size, 200000, [&](unsigned long long it) {
+            util::Array<double> joined = source + source;
+            sink = sink + joined[it % joined.Size()];
+        });
+
+        run("array/operator[]", size, 20000000 / size + 1, [&](unsigned long long) {
+            double acc = 0;
+            for (size_t i = 0; i < size; i++) acc += source[i];
+            sink = sink + acc;
+        });
+
+        run("array/at", size, 20000000 / size + 1, [&](unsigned long long) {
+            double acc = 0;
+            for (size_t i = 0; i < size; i++) {
+                util::Result<double&> value = source.at(i);
+                if (!value) acc += value();
+            }
+            sink = sink + acc;
+        });
+    }
+
+    util::String shortString("speed"), longString("motor controller diagnostics line");
+
+    run("string/copy/short", shortString.Size(), 2000000, [&](unsigned long long) {
+        util::String copy(shortString);
+        sink = sink + copy.Size();
+    });
+
+    run("string/copy/long", longString.Size(), 2000000, [&](unsigned long long) {
+        util::String copy(longString);
+        sink = sink + copy.Size();
+    });
+
+    run("string/concat", longString.Size() * 2, 2000000, [&](unsigned long long) {
+        util::String joined = shortString + ": " + longString;
+        sink = sink + joined.Size();
+    });
+}
+
+static void lookups() {
+    const size_t counts[] = {8, 64, 512};
+    for (size_t count : counts) {
+        util::Array<unsigned long long> ids(count);
+        util::FlatMap<unsigned long long, size_t> map;
+        for (size_t i = 0; i < count; i++) {
+            ids[i] = 0x200 + i * 3;
+            (void)map.insert(ids[i], i);
+        }
+
+        run("lookup/linear", count, 20000000 / count + 1000, [&](unsigned long long it) {
+            const unsigned long long id = ids[(it * 7) % count];
+            size_t i = 0;
+            while (i < count && ids[i] != id) i++;
+            sink = sink + static_cast<double>(i);
+        });
+
+        run("lookup/flatmap", count, 20000000 / count + 1000, [&](unsigned long long it) {
+            const size_t *index = map.find(ids[(it * 7) % count]);
+            sink = sink + static_cast<double>(*index);
+        });
+    }
+}
+
+static void formatting() {
+    char buffer[64];
+
+    run("format/to_chars/int", 1, 10000000, [&](unsigned long long it) {
+        util::Result<char*> end = util::to_chars(buffer, buffer + sizeof(buffer), -static_cast<long long>(it * 7919));
+        sink = sink + static_cast<double>(end() - buffer);
+    });
+
+    run("format/snprintf/int", 1, 10000000, [&](unsigned long long it) {
+        int length = snprintf(buffer, sizeof(buffer), "%lld", -static_cast<long long>(it * 7919));
+        sink = sink + length;
+    });
+
+    run("format/to_string/int", 1, 10000000, [&](unsigned long long it) {
+        util::String text = util::to_string(-static_cast<long long>(it * 7919));
+        sink = sink + static_cast<double>(text.Size());
+    });
+
+    run("format/to_chars/double", 3, 5000000, [&](unsigned long long it) {
+        util::Result<char*> end = util::to_chars(buffer, buffer + sizeof(buffer), static_cast<double>(it) * -0.731, 3);
+        sink = sink + static_cast<double>(end() - buffer);
+    });
+
+    run("format/snprintf/double", 3, 5000000, [&](unsigned long long it) {
+        int length = snprintf(buffer, sizeof(buffer), "%.3f", static_cast<double>(it) * -0.731);
+        sink = sink + length;
+    });
+
+    run("format/to_string/double", 3, 5000000, [&](unsigned long long it) {
+        util::String text = util::to_string(static_cast<double>(it) * -0.731, 3);
+        sink = sink + static_cast<double>(text.Size());
+    });
+}
+
+static void vectors() {
+    const size_t sizes[] = {3, 64};
+    for (size_t size : sizes) {
+        util::Vector<double> a{util::Array<double>(size)}, b{util::Array<double>(size)}, out{util::Array<double>(size)};
+        for (size_t i = 0; i < size; i++) {
+            a[i] = 1.0 + 0.25 * static_cast<double>(i);
+            b[i] = -0.5 + 0.125 * static_cast<double>(i);
+        }
+
+        run("vector/axpy", size, 2000000, [&](unsigned long long it) {
+            out = a + b * 1.75;
+            sink = sink + out[it % size];
+        });
+
+        run("vector/dot", size, 2000000, [&](unsigned long long) {
+            sink = sink + a.dot(b);
+        });
+
+        run("vector/module", size, 2000000, [&](unsigned long long) {
+            sink = sink + a.module();
+        });
+    }
+}
+
+static void scalars() {
+    util::Range<double> from(-1, 1), to(-255, 255);
+
+    run("range/map", 1, 20000000, [&](unsigned long long it) {
+        sink = sink + to.mapValueFromRange(static_cast<double>(it % 2000) * 0.001 - 1.0, from);
+    });
+
+    MockMotor controller(motor::MotorInfo(45, 0.05, 0.2, motor::SpeedRange(-255, 255), motor::SpeedRange(-1, 1)));
+    motor::controllers::RangedSpeedController& base = controller;
+
+    run("controller/setSpeed", 1, 20000000, [&](unsigned long long it) {
+        (void)base.setSpeed(static_cast<double>(it % 2000) * 0.001 - 1.0);
+    });
+
+    CrtpMockMotor crtpController(motor::MotorInfo(45, 0.05, 0.2, motor::SpeedRange(-255, 255), motor::SpeedRange(-1, 1)));
+
+    run("controller/setSpeed/crtp", 1, 20000000, [&](unsigned long long it) {
+        (void)crtpController.setSpeed(static_cast<double>(it % 2000) * 0.001 - 1.0);
+    });
+
+    run("result/ok", 1, 20000000, [&](unsigned long long it) {
+        util::Result<double> value = static_cast<double>(it);
+        if (!value) sink = sink + value();
+    });
+
+    run("result/error", 1, 20000000, [&](unsigned long long it) {
+        util::Result<double> value = util::Error(util::ErrorCode::outOfRange, "benchmark");
+        if (value) sink = sink + static_cast<double>(it);
+    });
+}
+
+static void calculatorsAndPlatform() {
+    const size_t counts[] = {4, 16, 64, 256, 1024};
+    for (size_t count : counts) {
+        platform::PlatformMotorConfig config = makeConfig(count);
+
+        run("platform/updateParallelAxises", count, 2000000 / count + 1, [&](unsigned long long) {
+            platform::PlatformMotorConfig updated = platform::updateParallelAxisesForMotors(config, 2);
+            sink = sink + updated[0].parallelAxisesAmount;
+        });
+
+        platform::PlatformMotorConfig updated = platform::updateParallelAxisesForMotors(config, 2);
+
+        run("calculators/platformLinearSpeeds", count, 4000000 / count + 1, [&](unsigned long long it) {
+            util::Result<platform::PlatformMotorSpeeds> speeds = calculators::calculatePlatformLinearSpeeds(updated, static_cast<double>(it % 360), 0.5);
+            if (!speeds) sink = sink + speeds()[0];
+        });
+
+        platform::PlatformMotorSpeeds buffer(count);
+
+        run("calculators/platformLinearSpeeds/span", count, 4000000 / count + 1, [&](unsigned long long it) {
+            util::Error err = calculators::calculatePlatformLinearSpeeds(updated, static_cast<double>(it % 360), 0.5, buffer);
+            if (!err) sink = sink + buffer[0];
+        });
+
+        run("calculators/platformLinearSpeeds/span/polynomial", count, 4000000 / count + 1, [&](unsigned long long it) {
+            util::Error err = calculators::calculatePlatformLinearSpeeds<util::TrigPolynomial>(updated, static_cast<double>(it % 360), 0.5, buffer);
+            if (!err) sink = sink + buffer[0];
+        });
+
+        platform::Platform<MockMotor> robot(config, 2);
+        platform::PlatformMotorSpeeds speeds(count);
+        for (size_t i = 0; i < count; i++) speeds[i] = 0.5;
+
+        run("platform/setSpeeds", count, 4000000 / count + 1, [&](unsigned long long) {
+            (void)robot.setSpeeds(speeds);
+        });
+
+        platform::Platform<CrtpMockMotor> crtpRobot(config, 2);
+
+        run("platform/setSpeeds/crtp", count, 4000000 / count + 1, [&](unsigned long long) {
+            (void)crtpRobot.setSpeeds(speeds);
+        });
+
+        if (count == 4) {
+            platform::StaticMotorConfig<4> staticConfig;
+            for (size_t i = 0; i < count; i++) (void)staticConfig.push_back(config[i]);
+            platform::StaticPlatform<MockMotor, 4> staticRobot(staticConfig, 2);
+            platform::StaticPlatform<CrtpMockMotor, 4> staticCrtpRobot(staticConfig, 2);
+            platform::StaticMotorSpeeds<4> staticSpeeds;
+            for (size_t i = 0; i < count; i++) (void)staticSpeeds.push_back(0.5);
+
+            run("platform/setSpeeds/static", count, 4000000, [&](unsigned long long) {
+                (void)staticRobot.setSpeeds(staticSpeeds);
+            });
+
+            run("platform/setSpeeds/static/crtp", count, 4000000, [&](unsigned long long) {
+                (void)staticCrtpRobot.setSpeeds(staticSpeeds);
+            });
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--csv] [--filter <text>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (csv) {
+        printf("name,n,ns_per_op,allocs_per_op\n");
+    } else {
+        printf("%-48s %8s %12s %14s\n", "case", "n", "ns/op", "allocs/op");
+    }
+
+    containers();
+    lookups();
+    formatting();
+    vectors();
+    scalars();
+    calculatorsAndPlatform();
+
+    return 0;
+}
@@ -0,0 +1,733 @@
+// Regression self-checks, registered with ctest.
+//
+// Every check prints a line only when it fails; the exit code is the number
+// of failed checks.
+//
+// Build: g++ -std=c++17 -O2 -pthread -Iinclude bench/checks.cpp bench/checks_link.cpp -o checks
+
+#include "vislib.hpp"
+
+#include <math.h>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <type_traits>
+
+static unsigned long long allocationCount = 0;
+
+void* operator new(std::size_t size) {
+    allocationCount++;
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    allocationCount++;
+    return malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { free(ptr); }
+
+namespace util = vislib::util;
+namespace motor = vislib::motor;
+namespace platform = vislib::platform;
+
+static int failures = 0;
+
+double linkedCosDegrees(double angle);
+
+static void check(bool condition, const char* name) {
+    if (condition) return;
+    failures++;
+    printf("FAILED: %s\n", name);
+}
+
+class MockMotor : public motor::controllers::RangedSpeedController {
+protected:
+    motor::Speed raw = 0;
+
+    util::Error setSpeedRaw(motor::Speed speed) noexcept override {
+        raw = speed;
+        return util::Error();
+    }
+
+    util::Result<motor::Speed> getSpeedRaw() const noexcept override {
+        return raw;
+    }
+
+public:
+    using motor::controllers::RangedSpeedController::RangedSpeedController;
+
+    util::Error init(int) noexcept {
+        return util::Error();
+    }
+};
+
+class FixedMockMotor : public motor::controllers::BasicRangedSpeedController<util::Q16> {
+protected:
+    util::Q16 raw = 0;
+
+    util::Error setSpeedRaw(util::Q16 speed) noexcept override {
+        raw = speed;
+        return util::Error();
+    }
+
+    util::Result<util::Q16> getSpeedRaw() const noexcept override {
+        return raw;
+    }
+
+public:
+    using motor::controllers::BasicRangedSpeedController<util::Q16>::BasicRangedSpeedController;
+
+    util::Error init(int) noexcept {
+        return util::Error();
+    }
+
+    util::Q16 Raw() const noexcept {
+        return raw;
+    }
+};
+
+// Heap allocator that refuses every allocation once its budget of successful ones is spent.
+struct BudgetAllocator {
+    static inline int budget = 0;
+
+    void* allocate(size_t bytes, size_t alignment = util::DEFAULT_ALIGNMENT) noexcept {
+        if (budget <= 0) return nullptr;
+        budget--;
+        return util::HeapAllocator().allocate(bytes, alignment);
+    }
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment = util::DEFAULT_ALIGNMENT) noexcept {
+        util::HeapAllocator().deallocate(ptr, bytes, alignment);
+    }
+};
+
+// Commits all motors in one call, so Platform needs its raw speeds buffer.
+class BatchMockMotor : public MockMotor {
+public:
+    using MockMotor::MockMotor;
+
+    static util::Error setSpeedsRaw(BatchMockMotor* controllers, const motor::Speed* raw, size_t count) noexcept {
+        for (size_t i = 0; i < count; i++) controllers[i].raw = raw[i];
+        return util::Error();
+    }
+};
+
+static motor::MotorInfo makeMotor(double angle) {
+    return motor::MotorInfo(angle, 0.05, 0.2, motor::SpeedRange(-255, 255), motor::SpeedRange(-1, 1));
+}
+
+static double nextRandom(unsigned& state) {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<double>(state >> 8) / 16777216.0;
+}
+
+struct alignas(64) CacheLine {
+    double values[8];
+};
+
+static void memory() {
+    bool aligned = true;
+    for (int i = 0; i < 50; i++) {
+        util::Array<CacheLine> array(3);
+        util::DynamicArray<CacheLine> dynamic;
+        (void)dynamic.push_back(CacheLine());
+        aligned = aligned && array.Size() == 3 && reinterpret_cast<size_t>(array.Data()) % 64 == 0;
+        aligned = aligned && reinterpret_cast<size_t>(dynamic.Data()) % 64 == 0;
+    }
+    check(aligned, "memory/heap/over-aligned");
+
+    using PoolPtr = util::UniquePtr<int, util::deleter, util::PoolAllocator>;
+    static_assert(!std::is_constructible<PoolPtr, int*>::value, "pool owned pointers must not adopt a plain new");
+    static_assert(std::is_constructible<util::UniquePtr<int>, int*>::value, "heap owned pointers adopt a plain new");
+
+    util::StaticPool<sizeof(int), 4> pool;
+    util::PoolAllocator poolAllocator(pool);
+    {
+        PoolPtr owned = PoolPtr::adopt(poolAllocator.create<int>(5), poolAllocator);
+        check(*owned == 5 && pool.freeBlocks() == 3, "memory/unique-ptr/adopt");
+    }
+    check(pool.freeBlocks() == 4, "memory/unique-ptr/adopt-returns-block");
+
+#if VISLIB_INSTRUMENTATION
+    util::instrumentation::resetAllocationStats();
+#endif
+    {
+        util::UniquePtr<int> heap(new (std::nothrow) int(7));
+        heap.reset(new (std::nothrow) int(8));
+        check(*heap == 8, "memory/unique-ptr/adopt-new");
+    }
+#if VISLIB_INSTRUMENTATION
+    const util::instrumentation::AllocationStats& stats = util::instrumentation::allocationStats;
+    check(stats.allocations == 2 && stats.deallocations == 2 && stats.liveBytes == 0, "memory/unique-ptr/adopt-new-counted");
+#endif
+}
+
+// Counts live instances, so leftovers in a container are seen being destroyed.
+struct Counted {
+    static inline int live = 0;
+    int value = 0;
+
+    Counted() noexcept { live++; }
+    Counted(int p_value) noexcept : value(p_value) { live++; }
+    Counted(const Counted& other) noexcept : value(other.value) { live++; }
+    Counted& operator=(const Counted& other) noexcept = default;
+    ~Counted() noexcept { live--; }
+};
+
+// Starts the head and tail counters just short of their wrap around.
+template<typename T, size_t N> class NearWrapRing : public util::SpscRingBuffer<T, N> {
+public:
+    NearWrapRing() noexcept {
+        this->head = this->tail = this->cachedHead = this->cachedTail = static_cast<vislib::ul_t>(~static_cast<vislib::ul_t>(0) - 2);
+    }
+};
+
+static void rings() {
+    util::SpscRingBuffer<int, 4> ring;
+    int value = 0;
+    check(ring.try_pop(value).errcode == util::ErrorCode::emptyArray, "ring/empty");
+    for (int i = 0; i < 4; i++) (void)ring.try_push(i);
+    check(ring.try_push(4).errcode == util::ErrorCode::capacityExceeded && ring.Size() == 4, "ring/full");
+
+    // Ten laps over four slots keep the order.
+    bool ordered = true;
+    for (int i = 0; i < 40; i++) {
+        ordered = ordered && !ring.try_pop(value) && value == i && !ring.try_push(i + 4);
+    }
+    check(ordered && ring.Size() == 4, "ring/wrap-around");
+
+    NearWrapRing<int, 4> wrapping;
+    bool wraps = true;
+    for (int i = 0; i < 12; i++) {
+        wraps = wraps && !wrapping.try_push(i) && !wrapping.try_pop(value) && value == i;
+    }
+    check(wraps && wrapping.empty(), "ring/counter-wrap");
+
+    util::SpscRingBuffer<int, 8> batch;
+    const int items[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    int popped[10] = {};
+    check(batch.try_push(items, 5) == 5 && batch.try_push(items + 5, 5) == 3, "ring/batch-push-partial");
+    check(batch.try_pop(popped, 3) == 3 && batch.try_pop(popped + 3, 10) == 5 && memcmp(popped, items, sizeof(int) * 8) == 0, "ring/batch-pop-partial");
+    check(batch.try_pop(popped, 4) == 0 && batch.try_push(items, 8) == 8 && batch.try_push(items, 1) == 0, "ring/batch-empty-and-full");
+
+    {
+        util::SpscRingBuffer<Counted, 8> leftovers;
+        for (int i = 0; i < 5; i++) (void)leftovers.try_push(Counted(i));
+        Counted out;
+        (void)leftovers.try_pop(out);
+        check(Counted::live == 5, "ring/live-elements");
+    }
+    check(Counted::live == 0, "ring/destroys-leftovers");
+
+    // Producer and consumer on their own threads, mixing single and batch calls. Both yield when the
+    // ring gives them nothing so the run also finishes on a single core.
+    constexpr int total = 200000;
+    util::SpscRingBuffer<int, 64> shared;
+    std::thread producer([&shared] {
+        int next = 0;
+        int chunk[7];
+        while (next < total) {
+            if (next % 3 == 0) {
+                int n = 0;
+                while (n < 7 && next + n < total) {
+                    chunk[n] = next + n;
+                    n++;
+                }
+                const int pushed = static_cast<int>(shared.try_push(chunk, static_cast<size_t>(n)));
+                next += pushed;
+                if (pushed == 0) std::this_thread::yield();
+            } else if (!shared.try_push(next)) {
+                next++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    bool inOrder = true;
+    int chunk[5];
+    while (expected < total) {
+        if (expected % 2 == 0) {
+            const size_t n = shared.try_pop(chunk, 5);
+            for (size_t i = 0; i < n; i++, expected++) {
+                if (chunk[i] != expected) inOrder = false;
+            }
+            if (n == 0) std::this_thread::yield();
+        } else if (!shared.try_pop(value)) {
+            if (value != expected) inOrder = false;
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    check(inOrder && shared.empty(), "ring/two-threads");
+}
+
+static void strings() {
+    util::String small("abcdefghijklmn");
+    small += small;
+    check(small == "abcdefghijklmnabcdefghijklmn", "string/self-append/inline");
+
+    util::String large("motor controller diagnostics line");
+    large += large;
+    check(large.Size() == 66 && strncmp(large.c_str(), "motor controller diagnostics linemotor", 38) == 0, "string/self-append/heap");
+
+    util::String tail("0123456789");
+    tail.append(tail.c_str() + 5, 5);
+    check(tail == "012345678956789", "string/self-append/substring");
+
+    using ArenaString = util::BasicString<util::ArenaAllocator>;
+    util::StaticArena<512> arena;
+    ArenaString prefix("0123456789012345678901234567890123456789", util::ArenaAllocator(arena));
+    check((prefix + "tail").Size() == 44 && !(prefix + "tail").Truncated(), "string/arena/operator+");
+    check(ArenaString::concat(prefix, "x").Size() == 41, "string/arena/concat");
+
+    ArenaString orphan("0123456789012345678901234567890123456789");
+    check(orphan.Truncated() && orphan.Size() == 22, "string/no-resource/truncated");
+    check((orphan + "x").Truncated(), "string/no-resource/truncation-propagates");
+
+    check(util::to_string(1.25, 40) == "1.250000000000000000", "string/to-string/precision-clamped");
+}
+
+// to_chars output for value at precision against snprintf("%.*f").
+static bool sameAsPrintf(double value, int precision) {
+    char expected[64];
+    char actual[64];
+    const int length = snprintf(expected, sizeof(expected), "%.*f", precision, value);
+    util::Result<char*> end = util::to_chars(actual, actual + sizeof(actual), value, static_cast<size_t>(precision));
+    return !end && end() - actual == length && strncmp(actual, expected, static_cast<size_t>(length)) == 0;
+}
+
+static void formatting() {
+    const double ties[] = {0.5, 1.5, 2.5, 3.5, 0.125, 0.375, 0.625, 2.675, 1.005, 0.0, -0.0, -0.5, -2.5, -0.0004, 1e-7, 9.5, 99.95, 0.999999999999999};
+    bool tiesMatch = true;
+    for (double value : ties) {
+        for (int precision = 0; precision <= 15; precision++) tiesMatch = tiesMatch && sameAsPrintf(value, precision);
+    }
+    check(tiesMatch, "format/to-chars/ties-vs-printf");
+
+    // Magnitudes from 1e-6 to 1e18, both signs, every precision from 0 to 15.
+    unsigned state = 3;
+    bool randomMatch = true;
+    for (int magnitude = -6; magnitude <= 18 && randomMatch; magnitude++) {
+        for (int k = 0; k < 200 && randomMatch; k++) {
+            double value = nextRandom(state) * util::powerOfTen(static_cast<size_t>(magnitude + 6)) / 1e6;
+            if (k % 2 != 0) value = -value;
+            for (int precision = 0; precision <= 15; precision++) randomMatch = randomMatch && sameAsPrintf(value, precision);
+        }
+    }
+    check(randomMatch, "format/to-chars/random-vs-printf");
+
+    check(util::to_string(-0.0, 3) == "-0.000" && util::to_string(-0.0004, 3) == "-0.000", "format/to-string/negative-zero");
+
+    // "-12.50" needs six characters, five must be refused without touching the buffer.
+    char buf[8] = "xxxxxxx";
+    check(util::to_chars(buf, buf + 5, -12.5, 2).Err().errcode == util::ErrorCode::capacityExceeded && strcmp(buf, "xxxxxxx") == 0, "format/to-chars/too-small");
+    util::Result<char*> exact = util::to_chars(buf, buf + 6, -12.5, 2);
+    check(!exact && exact() == buf + 6 && strncmp(buf, "-12.50", 6) == 0, "format/to-chars/exact-fit");
+    check(util::to_chars(buf, buf + 2, -0.0, 1).Err().errcode == util::ErrorCode::capacityExceeded, "format/to-chars/too-small/negative-zero");
+    check(util::to_chars(buf, buf + 2, 12345).Err().errcode == util::ErrorCode::capacityExceeded, "format/to-chars/too-small/integer");
+    check(util::to_chars(buf, buf + 8, 1.0, 19).Err().errcode == util::ErrorCode::invalidArgument, "format/to-chars/precision-limit");
+}
+
+// Sends the same random insert/overwrite/erase sequence over keys 0..255 to map and to a plain
+// presence table, comparing every lookup.
+template<typename Map> static bool matchesReference(Map& map, unsigned state) {
+    bool present[256] = {};
+    size_t values[256] = {};
+    size_t live = 0;
+    bool matches = true;
+    for (int step = 0; step < 20000 && matches; step++) {
+        const unsigned long long key = static_cast<unsigned long long>(nextRandom(state) * 256);
+        const double action = nextRandom(state);
+        if (action < 0.55) {
+            const size_t value = static_cast<size_t>(step);
+            matches = !map.insert(key, value);
+            if (!present[key]) live++;
+            present[key] = true;
+            values[key] = value;
+        } else if (action < 0.9) {
+            const util::Error err = map.erase(key);
+            matches = present[key] ? !err : err.errcode == util::ErrorCode::keyNotFound;
+            if (present[key]) live--;
+            present[key] = false;
+        } else {
+            const size_t* found = map.find(key);
+            matches = present[key] ? found != nullptr && *found == values[key] : found == nullptr;
+        }
+        matches = matches && map.Size() == live;
+    }
+    for (unsigned long long key = 0; key < 256 && matches; key++) {
+        const size_t* found = map.find(key);
+        matches = present[key] ? found != nullptr && *found == values[key] : found == nullptr;
+    }
+    return matches;
+}
+
+// Sixteen consecutive keys share a home slot, so probe chains run long and erase has to shift them back.
+struct ClusteringHash {
+    unsigned long long operator()(unsigned long long key) const noexcept {
+        return key >> 4;
+    }
+};
+
+static void flatMaps() {
+    using ArenaMap = util::FlatMap<unsigned long long, size_t, util::FlatHash<unsigned long long>, util::ArenaAllocator>;
+    util::StaticArena<8192> arena;
+    ArenaMap map{util::ArenaAllocator(arena)};
+    bool inserted = true;
+    for (unsigned long long key = 0; key < 100; key++) inserted = inserted && !map.insert(key * 7, static_cast<size_t>(key));
+    bool found = true;
+    for (unsigned long long key = 0; key < 100; key++) found = found && map.find(key * 7) != nullptr && *map.find(key * 7) == key;
+    check(inserted && found && map.Size() == 100 && arena.used() > 0, "flat-map/arena");
+
+    ArenaMap orphan;
+    check(orphan.insert(1, 1).errcode == util::ErrorCode::allocationFailed, "flat-map/no-resource");
+
+    util::FlatMap<unsigned long long, size_t> spread;
+    check(matchesReference(spread, 7u) && spread.Capacity() >= 128, "flat-map/random-vs-reference");
+    util::FlatMap<unsigned long long, size_t, ClusteringHash> clustered;
+    check(matchesReference(clustered, 11u), "flat-map/random-vs-reference/clustered");
+
+    // Eight requested entries round up to 16 slots, 14 of them usable under the 7/8 load limit.
+    util::StaticFlatMap<unsigned long long, size_t, 8> full;
+    bool filled = true;
+    for (unsigned long long key = 0; key < 14; key++) filled = filled && !full.insert(key * 3, static_cast<size_t>(key));
+    check(filled && full.Size() == 14 && full.Capacity() == 14, "flat-map/static/fills");
+    check(full.insert(100, 100).errcode == util::ErrorCode::capacityExceeded && full.Size() == 14 && !full.contains(100), "flat-map/static/rejects-15th");
+    check(!full.insert(9, 42) && *full.find(9) == 42 && full.Size() == 14, "flat-map/static/overwrite-when-full");
+    check(!full.erase(9) && !full.contains(9) && !full.insert(100, 100) && *full.find(100) == 100, "flat-map/static/erase-then-reinsert");
+    bool intact = true;
+    for (unsigned long long key = 0; key < 14; key++) {
+        if (key == 3) continue;
+        intact = intact && full.find(key * 3) != nullptr && *full.find(key * 3) == key;
+    }
+    check(intact && full.Size() == 14, "flat-map/static/others-intact");
+}
+
+static void platforms() {
+    platform::StaticMotorConfig<3> config;
+    (void)config.push_back(makeMotor(0));
+    (void)config.push_back(makeMotor(120));
+    (void)config.push_back(makeMotor(240));
+
+    platform::StaticPlatform<MockMotor, 2> tooSmall(config);
+    util::StaticVector<int, 3> ports;
+    (void)ports.push_back(1);
+    (void)ports.push_back(2);
+    (void)ports.push_back(3);
+    check(tooSmall.init(ports).err.errcode == util::ErrorCode::capacityExceeded, "platform/static/capacity-exceeded");
+
+    check(platform::StaticMotorConfig<2>::create(config.Data(), config.Size()).Err().errcode == util::ErrorCode::capacityExceeded, "static-vector/create/capacity-exceeded");
+    util::Result<platform::StaticMotorConfig<3>> copied = platform::StaticMotorConfig<3>::create(config.Data(), config.Size());
+    check(!copied && copied().Size() == 3 && copied()[2].anglePos == 240, "static-vector/create/fits");
+
+    platform::StaticPlatform<MockMotor, 3> fits(config);
+    check(!fits.init(ports) && fits.Controllers().Size() == 3, "platform/static/fits");
+
+    platform::PlatformMotorConfig heapConfig(3);
+    for (size_t i = 0; i < 3; i++) heapConfig[i] = config[i];
+    platform::PlatformMotorSpeeds speeds(3);
+    for (size_t i = 0; i < 3; i++) speeds[i] = 0.5;
+
+    platform::StaticMotorConfig<2> shortConfig;
+    (void)shortConfig.push_back(makeMotor(0));
+    platform::HeterogeneousPlatform<MockMotor, MockMotor> mixed(shortConfig);
+    check(mixed.init(1, 2).err.errcode == util::ErrorCode::invalidArgument, "platform/heterogeneous/short-config-init");
+    platform::StaticMotorSpeeds<2> mixedSpeeds;
+    (void)mixedSpeeds.push_back(0.5);
+    (void)mixedSpeeds.push_back(0.5);
+    check(mixed.setSpeeds(mixedSpeeds).errcode == util::ErrorCode::invalidArgument, "platform/heterogeneous/short-config-speeds");
+
+    // The controllers fit the budget, the raw speeds buffer does not.
+    BudgetAllocator::budget = 1;
+    platform::Platform<BatchMockMotor, util::Array<BatchMockMotor, BudgetAllocator>> starved(heapConfig);
+    check(starved.ConstructionError().errcode == util::ErrorCode::allocationFailed, "platform/raw-speeds/construction-error");
+    check(starved.setSpeeds(speeds).errcode == util::ErrorCode::allocationFailed, "platform/raw-speeds/set-speeds-fails");
+}
+
+// Deterministic pseudo random value in [0, 1), so failures reproduce.
+static bool sameAmounts(const platform::StaticMotorConfig<16>& config) {
+    platform::StaticMotorConfig<16> recount = config;
+    (void)platform::countParallelAxises(recount, 0);
+    for (size_t i = 0; i < config.Size(); i++) {
+        if (config[i].parallelAxisesAmount != recount[i].parallelAxisesAmount) return false;
+    }
+    return true;
+}
+
+static void axes() {
+    platform::StaticMotorConfig<4> config;
+    (void)config.push_back(makeMotor(89.4));
+    (void)config.push_back(makeMotor(89.5));
+    (void)config.push_back(makeMotor(30));
+    config = platform::updateParallelAxisesForMotors(config, 0);
+    check(config[0].parallelAxisesAmount == 2 && config[1].parallelAxisesAmount == 2 && config[2].parallelAxisesAmount == 1, "axes/tolerance");
+
+    platform::StaticMotorConfig<3> wrapped;
+    (void)wrapped.push_back(makeMotor(-0.2));
+    (void)wrapped.push_back(makeMotor(0.1));
+    (void)wrapped.push_back(makeMotor(359.7));
+    wrapped = platform::updateParallelAxisesForMotors(wrapped, 0);
+    check(wrapped[0].parallelAxisesAmount == 3 && wrapped[2].parallelAxisesAmount == 3, "axes/wrap");
+
+    platform::StaticMotorConfig<3> chained;
+    (void)chained.push_back(makeMotor(10.0));
+    (void)chained.push_back(makeMotor(10.05));
+    (void)chained.push_back(makeMotor(10.1));
+    platform::ParallelAxisIndex<> index(1);
+    check(!index.build(chained) && chained[0].parallelAxisesAmount == 3 && index.Size() == 1, "axes/index/chain");
+    check(!index.remove(chained, 1) && chained[0].parallelAxisesAmount == 1 && chained[2].parallelAxisesAmount == 1 && index.Size() == 2, "axes/index/split");
+
+    platform::ParallelAxisIndex<> coarse(0);
+    check(!coarse.build(config) && coarse.amount(89.45) == 2 && coarse.amount(60) == 0, "axes/index/amount");
+    (void)config.push_back(makeMotor(269.9));
+    check(!coarse.add(config, 3) && config[0].parallelAxisesAmount == 3 && config[3].parallelAxisesAmount == 3, "axes/index/add");
+
+    // Random edits on a quarter degree grid, so gaps of exactly the tolerance come up often.
+    unsigned state = 7;
+    platform::StaticMotorConfig<16> grown;
+    platform::ParallelAxisIndex<> incremental(0);
+    bool matches = true;
+    for (int k = 0; k < 16; k++) {
+        (void)grown.push_back(makeMotor(0.25 * static_cast<double>(static_cast<int>(nextRandom(state) * 1440) - 720)));
+        matches = matches && !incremental.add(grown, grown.Size() - 1) && sameAmounts(grown);
+    }
+    for (int k = 0; k < 200; k++) {
+        const size_t moved = static_cast<size_t>(nextRandom(state) * 16);
+        matches = matches && !incremental.remove(grown, moved);
+        grown[moved].anglePos = grown[moved].anglePos + 0.25 * static_cast<double>(static_cast<int>(nextRandom(state) * 9) - 4);
+        matches = matches && !incremental.add(grown, moved) && sameAmounts(grown);
+    }
+    check(matches, "axes/index/matches-recount");
+}
+
+template<typename M> static double maxDifference(const M& x, const M& y) {
+    double worst = 0;
+    for (size_t i = 0; i < M::Rows() * M::Cols(); i++) worst = fmax(worst, fabs(x.data[i] - y.data[i]));
+    return worst;
+}
+
+static void matrices() {
+    util::Matrix<double, 3, 3> square;
+    const double squareValues[] = {4, -2, 1, 3, 6, -4, 2, 1, 8};
+    for (size_t i = 0; i < 9; i++) square.data[i] = squareValues[i];
+    const util::Vec<double, 3> x(1.5, -2.0, 0.25);
+
+    util::Result<util::Vec<double, 3>> solved = util::solve(square, square * x);
+    check(!solved && fabs(solved()[0] - 1.5) < 1e-12 && fabs(solved()[1] + 2.0) < 1e-12 && fabs(solved()[2] - 0.25) < 1e-12, "matrix/solve/round-trip");
+
+    util::Result<util::Matrix<double, 3, 3>> inverted = util::inverse(square);
+    check(!inverted && maxDifference(square * inverted(), util::Matrix<double, 3, 3>::identity()) < 1e-12, "matrix/inverse/identity");
+
+    util::Matrix<double, 4, 3> tall;
+    const double tallValues[] = {1, 0, 0.2, 0, 1, -0.2, -1, 0, 0.2, 0.5, -1, 0.3};
+    for (size_t i = 0; i < 12; i++) tall.data[i] = tallValues[i];
+    util::Result<util::Matrix<double, 3, 4>> pseudo = util::pseudoInverse(tall);
+    check(!pseudo && maxDifference(tall * pseudo() * tall, tall) < 1e-12, "matrix/pseudo-inverse/residual");
+
+    util::Result<util::Vec<double, 3>> fitted = util::solveLeastSquares(tall, tall * x);
+    check(!fitted && fabs(fitted()[0] - 1.5) < 1e-12 && fabs(fitted()[1] + 2.0) < 1e-12 && fabs(fitted()[2] - 0.25) < 1e-12, "matrix/least-squares/consistent");
+
+    // Third row is the sum of the first two, and the last column of deficient repeats the first.
+    util::Matrix<double, 3, 3> singular = square;
+    for (size_t c = 0; c < 3; c++) singular(2, c) = square(0, c) + square(1, c);
+    util::Matrix<double, 4, 3> deficient = tall;
+    for (size_t r = 0; r < 4; r++) deficient(r, 2) = deficient(r, 0);
+    check(util::solve(singular, x).Err().errcode == util::ErrorCode::singularMatrix, "matrix/solve/singular");
+    check(util::inverse(singular).Err().errcode == util::ErrorCode::singularMatrix, "matrix/inverse/singular");
+    check(util::pseudoInverse(deficient).Err().errcode == util::ErrorCode::singularMatrix, "matrix/pseudo-inverse/singular");
+    check(util::solveLeastSquares(deficient, tall * x).Err().errcode == util::ErrorCode::singularMatrix, "matrix/least-squares/singular");
+
+    // Opposite wheels are parallel, so every motor shares its speed with one other.
+    platform::StaticMotorConfig<4> config;
+    for (size_t i = 0; i < 4; i++) (void)config.push_back(makeMotor(30.0 + 90.0 * static_cast<double>(i)));
+    config = platform::updateParallelAxisesForMotors(config, 2);
+    auto kinematics = platform::calculators::HolonomicKinematics<4>::create(config).take();
+
+    bool agrees = true;
+    for (int k = 0; k < 24; k++) {
+        const double angle = 15.0 * k - 40.0;
+        const util::Vec<double, 4> wheels = kinematics.wheelSpeeds(angle, 0.7);
+        util::Result<platform::StaticMotorSpeeds<4>> expected = platform::calculators::calculatePlatformLinearSpeeds(config, angle, 0.7);
+        agrees = agrees && !expected;
+        for (size_t i = 0; agrees && i < 4; i++) agrees = fabs(wheels[i] - expected()[i]) < 1e-12;
+    }
+    check(agrees, "kinematics/holonomic/matches-linear-speeds");
+
+    const util::Vec<double, 4> spin = kinematics.wheelSpeeds(platform::calculators::PlatformTwist(0, 0, 2.0));
+    check(fabs(spin[0] - 2.0 * 0.05 / (2 * 0.2)) < 1e-12, "kinematics/holonomic/rotation-shared");
+
+    util::Result<platform::calculators::PlatformTwist> recovered = kinematics.twist(kinematics.wheelSpeeds(platform::calculators::PlatformTwist(0.3, -0.4, 1.2)));
+    check(!recovered && fabs(recovered()[0] - 0.3) < 1e-12 && fabs(recovered()[1] + 0.4) < 1e-12 && fabs(recovered()[2] - 1.2) < 1e-12, "kinematics/holonomic/twist-round-trip");
+}
+
+static void plans() {
+    namespace calculators = platform::calculators;
+
+    platform::PlatformMotorConfig config(5);
+    for (size_t i = 0; i < config.Size(); i++) config[i] = makeMotor(17.0 + 72.0 * static_cast<double>(i));
+    auto plan = calculators::KinematicsPlan::create(config).take();
+
+    // 150 commands span two full batch blocks and a partial third.
+    const size_t count = 150;
+    calculators::MotionCommand commands[count];
+    unsigned state = 11;
+    for (size_t c = 0; c < count; c++) {
+        commands[c].angle = 720.0 * nextRandom(state) - 360.0;
+        commands[c].speed = 2.0 * nextRandom(state) - 1.0;
+    }
+
+    platform::PlatformMotorSpeeds table(config.Size() * count);
+    platform::PlatformMotorSpeeds single(config.Size());
+    bool agrees = !plan.computeBatch(commands, count, table);
+    for (size_t c = 0; agrees && c < count; c++) {
+        agrees = !plan.compute(commands[c].angle, commands[c].speed, single);
+        for (size_t m = 0; agrees && m < config.Size(); m++) {
+            agrees = fabs(table[calculators::KinematicsPlan::batchIndex(m, c, count)] - single[m]) < 1e-12;
+        }
+    }
+    check(agrees, "kinematics/plan/batch-matches-compute");
+
+    // Fixed point rounds the premultiplied batch basis differently, so only a few ulps apart.
+    using Q16 = util::Q16;
+    platform::BasicPlatformMotorConfig<Q16> fixedConfig(config.Size());
+    for (size_t i = 0; i < config.Size(); i++) fixedConfig[i] = motor::BasicMotorInfo<Q16>(config[i]);
+    auto fixedPlan = calculators::FixedKinematicsPlan<Q16>::create(fixedConfig).take();
+    calculators::BasicMotionCommand<Q16> fixedCommands[count];
+    for (size_t c = 0; c < count; c++) fixedCommands[c] = {Q16(commands[c].angle), Q16(commands[c].speed)};
+
+    platform::BasicPlatformMotorSpeeds<Q16> fixedTable(config.Size() * count);
+    platform::BasicPlatformMotorSpeeds<Q16> fixedSingle(config.Size());
+    bool fixedAgrees = !fixedPlan.computeBatch(fixedCommands, count, fixedTable);
+    for (size_t c = 0; fixedAgrees && c < count; c++) {
+        fixedAgrees = !fixedPlan.compute(fixedCommands[c].angle, fixedCommands[c].speed, fixedSingle);
+        for (size_t m = 0; fixedAgrees && m < config.Size(); m++) {
+            const double batched = static_cast<double>(fixedTable[calculators::FixedKinematicsPlan<Q16>::batchIndex(m, c, count)]);
+            fixedAgrees = fabs(batched - static_cast<double>(fixedSingle[m])) < 1e-3;
+        }
+    }
+    check(fixedAgrees, "kinematics/plan/fixed-batch-matches-compute");
+
+    check(plan.compute(0, 1.5, single).errcode == util::ErrorCode::outOfRange, "kinematics/plan/compute-out-of-range");
+    commands[100].speed = -1.5;
+    check(plan.computeBatch(commands, count, table).errcode == util::ErrorCode::outOfRange, "kinematics/plan/batch-out-of-range");
+}
+
+static void fixedPipeline() {
+    using Q16 = util::Q16;
+    platform::BasicPlatformMotorConfig<Q16> config(4);
+    for (size_t i = 0; i < 4; i++) {
+        config[i] = motor::BasicMotorInfo<Q16>(45.0 + 90.0 * static_cast<double>(i), 0.2, 0.5, util::Range<Q16>(-255, 255), util::Range<Q16>(-1, 1));
+    }
+
+    platform::Platform<FixedMockMotor> robot(config);
+    auto plan = platform::calculators::FixedKinematicsPlan<Q16>::create(config).take();
+    platform::BasicPlatformMotorSpeeds<Q16> speeds(4);
+
+    util::Error err = plan.compute(Q16(30), Q16(0.5), speeds);
+    if (!err) err = robot.setSpeeds(speeds);
+    check(!err, "fixed/pipeline/runs");
+
+    bool close = true;
+    for (size_t i = 0; i < 4; i++) {
+        const double expected = 0.5 * cos((30.0 - (45.0 + 90.0 * static_cast<double>(i))) * M_PI / 180.0) / 0.5;
+        close = close && fabs(static_cast<double>(speeds[i]) - expected) < 1e-3;
+        close = close && fabs(static_cast<double>(robot.Controllers()[i].Raw()) - 255.0 * expected) < 0.05;
+    }
+    check(close, "fixed/pipeline/matches-double");
+}
+
+static void ramps() {
+    // The acceleration limit holds on every step. The jerk limit holds on every step that does not
+    // snap onto the target, snapping ends the move and drops the acceleration to zero at once.
+    unsigned state = 1;
+    bool accelerationHolds = true;
+    bool jerkHolds = true;
+    for (int trial = 0; trial < 200; trial++) {
+        motor::MotorInfo info = makeMotor(0);
+        info.maxAcceleration = 0.5 + 5.0 * nextRandom(state);
+        info.maxJerk = 1.0 + 20.0 * nextRandom(state);
+        const double dt = 0.001 * (1.0 + 20.0 * nextRandom(state));
+
+        motor::SpeedRamp ramp(info);
+        double target = 0;
+        double previous = 0;
+        for (int k = 0; k < 5000; k++) {
+            if (k % 700 == 0) target = 2.0 * nextRandom(state) - 1.0;
+            const double speed = ramp.step(target, dt);
+            const double acceleration = ramp.Acceleration();
+            accelerationHolds = accelerationHolds && fabs(acceleration) <= info.maxAcceleration * (1 + 1e-9);
+            if (speed != target) jerkHolds = jerkHolds && fabs(acceleration - previous) <= info.maxJerk * dt * (1 + 1e-9);
+            previous = acceleration;
+        }
+    }
+    check(accelerationHolds, "ramp/acceleration-limit");
+    check(jerkHolds, "ramp/jerk-limit");
+
+    platform::PlatformMotorConfig config(5);
+    for (size_t i = 0; i < config.Size(); i++) {
+        config[i] = makeMotor(72.0 * static_cast<double>(i));
+        config[i].maxAcceleration = 1.0 + static_cast<double>(i);
+        config[i].maxJerk = 4.0 + 3.0 * static_cast<double>(i);
+    }
+
+    auto bank = platform::SpeedRampBank::create(config).take();
+    motor::SpeedRamp single[5];
+    for (size_t i = 0; i < config.Size(); i++) single[i] = motor::SpeedRamp(config[i]);
+
+    platform::PlatformMotorSpeeds targets(config.Size());
+    bool bitwise = true;
+    bool stepped = true;
+    const unsigned long long before = allocationCount;
+    for (int k = 0; k < 3000; k++) {
+        if (k % 400 == 0) {
+            for (size_t i = 0; i < targets.Size(); i++) targets[i] = 2.0 * nextRandom(state) - 1.0;
+        }
+        stepped = stepped && !bank.step(targets.Data(), 0.01);
+        for (size_t i = 0; i < config.Size(); i++) {
+            const double expected = single[i].step(targets[i], 0.01);
+            bitwise = bitwise && memcmp(&expected, &bank.Speeds()[i], sizeof(double)) == 0;
+        }
+    }
+    check(stepped && bitwise, "ramp/bank-matches-single");
+    check(allocationCount == before, "ramp/bank-step-no-allocation");
+
+    platform::Platform<MockMotor> robot(config);
+    auto ramp = platform::SpeedRampBank::create(config).take();
+    for (size_t i = 0; i < targets.Size(); i++) targets[i] = 1;
+    util::Error err = robot.setSpeedsRamped(targets, ramp, 0.01);
+    const double first = robot.Controllers()[0].getSpeed().take();
+    check(!err && first > 0 && first < 1 && fabs(first - ramp.Speeds()[0]) < 1e-9, "platform/set-speeds-ramped");
+
+    platform::PlatformMotorConfig shortConfig(2);
+    for (size_t i = 0; i < shortConfig.Size(); i++) shortConfig[i] = config[i];
+    auto shortRamp = platform::SpeedRampBank::create(shortConfig).take();
+    check(robot.setSpeedsRamped(targets, shortRamp, 0.01).errcode == util::ErrorCode::invalidArgument, "platform/set-speeds-ramped/size-mismatch");
+}
+
+int main() {
+    check(linkedCosDegrees(60) == util::cosDegrees(60), "headers/link-from-two-units");
+    memory();
+    rings();
+    strings();
+    formatting();
+    flatMaps();
+    platforms();
+    axes();
+    matrices();
+    plans();
+    fixedPipeline();
+    ramps();
+
+    if (failures == 0) printf("all checks passed\n");
+    return failures;
+}
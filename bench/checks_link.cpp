@@ -0,0 +1,7 @@
+// Second translation unit of vislib_checks, so a non-inline definition in any header fails to link.
+
+#include "vislib.hpp"
+
+double linkedCosDegrees(double angle) {
+    return vislib::util::cosDegrees(angle);
+}
@@ -0,0 +1,78 @@
+// Accuracy and speed table for the sincosDegrees precision policies.
+//
+// Error is the maximum absolute deviation of sin and cos from a long double
+// reference over [-720, 720] degrees.
+//
+// Build: g++ -std=c++17 -O2 -Iinclude bench/trig.cpp -o trig
+
+#include "vislib.hpp"
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+
+namespace util = vislib::util;
+namespace calculators = vislib::platform::calculators;
+
+static volatile double sink = 0;
+
+template <typename Policy> static double maxError() {
+    double worst = 0;
+    for (long i = -72000; i <= 72000; i++) {
+        double angle = static_cast<double>(i) * 0.01;
+        typename Policy::Scalar s = 0, c = 0;
+        util::sincosDegrees<Policy>(static_cast<typename Policy::Scalar>(angle), s, c);
+
+        long double radians = static_cast<long double>(angle) * 3.14159265358979323846264338327950288L / 180.0L;
+        double es = fabs(static_cast<double>(s - sinl(radians)));
+        double ec = fabs(static_cast<double>(c - cosl(radians)));
+        if (es > worst) worst = es;
+        if (ec > worst) worst = ec;
+    }
+    return worst;
+}
+
+template <typename Policy> static double nsPerSincos() {
+    const long iterations = 2000000;
+    typename Policy::Scalar acc = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; i++) {
+        typename Policy::Scalar s = 0, c = 0;
+        util::sincosDegrees<Policy>(static_cast<typename Policy::Scalar>(i % 7200) * static_cast<typename Policy::Scalar>(0.05), s, c);
+        acc += s + c;
+    }
+    auto end = std::chrono::steady_clock::now();
+    sink = sink + acc;
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+template <typename Policy> static double nsPerPlanCompute() {
+    vislib::motor::SpeedRange interfaceRange(-1, 1), rawRange(-255, 255);
+    vislib::motor::MotorInfo motors[4] = {
+        {45, 0.2, 0.05, rawRange, interfaceRange}, {135, 0.2, 0.05, rawRange, interfaceRange},
+        {225, 0.2, 0.05, rawRange, interfaceRange}, {315, 0.2, 0.05, rawRange, interfaceRange}};
+    vislib::platform::PlatformMotorConfig config(motors);
+    auto plan = calculators::BasicKinematicsPlan<util::Array<calculators::KinematicsTerm>, Policy>::create(config).take();
+
+    const long iterations = 1000000;
+    double out[4];
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; i++) {
+        (void)plan.compute(static_cast<double>(i % 3600) * 0.1, 0.5, out);
+        sink = sink + out[i & 3];
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+template <typename Policy> static void row(const char* name) {
+    printf("%-12s %14.3g %14.2f %18.2f\n", name, maxError<Policy>(), nsPerSincos<Policy>(), nsPerPlanCompute<Policy>());
+}
+
+int main() {
+    printf("%-12s %14s %14s %18s\n", "policy", "max abs error", "ns/sincos", "ns/plan compute");
+    row<util::TrigExact>("exact");
+    row<util::TrigPolynomial>("polynomial");
+    row<util::TrigTable>("table");
+    return 0;
+}
@@ -0,0 +1,94 @@
+// Allocation and timing comparison for util::Vector expressions.
+//
+// "materialized" evaluates every operator into its own Vector, which is
+// what the operators did before expression templates; "fused" evaluates
+// the whole expression in one loop into the destination.
+//
+// Build: g++ -std=c++17 -O2 -Iinclude bench/vector_expressions.cpp -o vector_expressions
+
+#include "vislib.hpp"
+
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static unsigned long long allocationCount = 0;
+
+void* operator new(std::size_t size) {
+    allocationCount++;
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    allocationCount++;
+    return malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { free(ptr); }
+
+namespace util = vislib::util;
+
+using Vec = util::Vector<double>;
+
+static Vec makeVector(size_t size, double seed) {
+    Vec v{util::Array<double>(size)};
+    for (size_t i = 0; i < size; i++) v[i] = seed + 0.37 * static_cast<double>(i);
+    return v;
+}
+
+static Vec materialized(const Vec& a, const Vec& b, const Vec& c, double k) {
+    Vec scaled = b * k;
+    Vec sum = a + scaled;
+    Vec result = sum - c;
+    return result;
+}
+
+int main() {
+    const size_t sizes[] = {3, 16, 256, 4096};
+    const size_t iterations = 20000;
+
+    printf("%-8s %-14s %14s %12s %10s\n", "size", "mode", "allocs/iter", "ns/iter", "identical");
+
+    for (size_t size : sizes) {
+        Vec a = makeVector(size, 1.0), b = makeVector(size, -2.5), c = makeVector(size, 0.125);
+        const double k = 1.75;
+
+        Vec reference = materialized(a, b, c, k);
+        Vec fused = a + b * k - c;
+        bool identical = memcmp(reference.raw().Data(), fused.raw().Data(), sizeof(double) * size) == 0;
+
+        Vec out = makeVector(size, 0.0);
+        double sink = 0;
+
+        unsigned long long before = allocationCount;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t it = 0; it < iterations; it++) {
+            Vec r = materialized(a, b, c, k);
+            sink += r[it % size];
+        }
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+        printf("%-8llu %-14s %14.2f %12.1f %10s\n", (unsigned long long)size, "materialized",
+               double(allocationCount - before) / iterations, ns, "-");
+
+        before = allocationCount;
+        start = std::chrono::steady_clock::now();
+        for (size_t it = 0; it < iterations; it++) {
+            out = a + b * k - c;
+            sink += out[it % size];
+        }
+        end = std::chrono::steady_clock::now();
+        ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+        printf("%-8llu %-14s %14.2f %12.1f %10s\n", (unsigned long long)size, "fused",
+               double(allocationCount - before) / iterations, ns, identical ? "yes" : "NO");
+
+        if (sink == 0.123456789) printf("%f\n", sink);
+    }
+
+    return 0;
+}
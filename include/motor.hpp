@@ -8,79 +8,361 @@ using Speed = double;
 
 using SpeedRange = util::Range<Speed>;
 
-class MotorInfo {
+// Speed ranges are generic over the scalar type S, so a controller can run its mapping in
+// util::Fixed integer math. The double based names below are the defaults used by platforms.
+template <typename S> class BasicMotorInfo {
 public:
+    using Scalar = S;
+
     double anglePos = 0;
     double distance = 1;
     double wheelR = 1;
-    SpeedRange speedRange;
-    SpeedRange interfaceSpeedRange;
+    util::Range<S> speedRange;
+    util::Range<S> interfaceSpeedRange;
     bool isReversed = false;
     
     size_t parallelAxisesAmount = 1;
     
-    MotorInfo() = default;
+    // Interface speed units per second and per second squared, 0 disables the limit.
+    S maxAcceleration = 0;
+    S maxJerk = 0;
+    
+    BasicMotorInfo() = default;
     
-    MotorInfo(double p_ap, double p_d, double p_wr, SpeedRange p_speed, SpeedRange p_intSpeed, bool p_reversed = false) noexcept
+    BasicMotorInfo(double p_ap, double p_d, double p_wr, util::Range<S> p_speed, util::Range<S> p_intSpeed, bool p_reversed = false) noexcept
     : anglePos(p_ap), distance(p_d), wheelR(p_wr), speedRange(p_speed), interfaceSpeedRange(p_intSpeed), isReversed(p_reversed) {}
+
+    template <typename O> BasicMotorInfo(const BasicMotorInfo<O>& other) noexcept
+    : anglePos(other.anglePos), distance(other.distance), wheelR(other.wheelR), speedRange(other.speedRange), interfaceSpeedRange(other.interfaceSpeedRange),
+    isReversed(other.isReversed), parallelAxisesAmount(other.parallelAxisesAmount),
+    maxAcceleration(static_cast<S>(other.maxAcceleration)), maxJerk(static_cast<S>(other.maxJerk)) {}
+    
+};
+
+using MotorInfo = BasicMotorInfo<Speed>;
+
+// One tick of a slew rate and jerk limited ramp of speed towards target, invDt is 1 / dt.
+// The acceleration is kept low enough to come to rest exactly at the target and the speed snaps
+// onto the target once it would be crossed. Written without data dependent control flow so a loop
+// over many motors vectorizes.
+template <typename S> inline void rampStep(S& speed, S& acceleration, S target, S maxAcceleration, S maxJerk, S dt, S invDt) noexcept {
+    using util::sqrtF;
+    
+    const S error = target - speed;
+    const S absError = util::absF(error);
+    
+    const S jerkStep = maxJerk * dt;
+    
+    // Largest acceleration that can still be ramped down to zero in jerk limited steps of dt before
+    // reaching the target, the positive root of a^2 + jerkStep * a = 2 * maxJerk * absError.
+    S magnitude = absError * invDt;
+    const S braking = (sqrtF(S(jerkStep * jerkStep + static_cast<S>(8) * maxJerk * absError)) - jerkStep) * static_cast<S>(0.5);
+    const S jerkLimited = util::minF(magnitude, braking);
+    magnitude = maxJerk > static_cast<S>(0) ? jerkLimited : magnitude;
+    const S accelerationLimited = util::minF(magnitude, maxAcceleration);
+    magnitude = maxAcceleration > static_cast<S>(0) ? accelerationLimited : magnitude;
+    
+    const S desired = error < static_cast<S>(0) ? S(-magnitude) : magnitude;
+    const S limited = util::maxF(S(acceleration - jerkStep), util::minF(S(acceleration + jerkStep), desired));
+    const S next = maxJerk > static_cast<S>(0) ? limited : desired;
+    const S moved = speed + next * dt;
+    
+    const bool reached = (error < static_cast<S>(0)) == (moved <= target);
+    speed = reached ? target : moved;
+    acceleration = reached ? static_cast<S>(0) : next;
+}
+
+// Per motor ramping state, limits are taken from the motor info.
+template <typename S> class BasicSpeedRamp {
+protected:
+    S speed = 0;
+    S acceleration = 0;
+    S maxAcceleration = 0;
+    S maxJerk = 0;
+    
+public:
+    BasicSpeedRamp() = default;
+    
+    BasicSpeedRamp(const BasicMotorInfo<S>& info, S initial = 0) noexcept
+    : speed(initial), maxAcceleration(info.maxAcceleration), maxJerk(info.maxJerk) {}
+    
+    S step(S target, S dt) noexcept {
+        if (!(dt > static_cast<S>(0))) return speed;
+        rampStep(speed, acceleration, target, maxAcceleration, maxJerk, dt, S(static_cast<S>(1) / dt));
+        return speed;
+    }
+    
+    void reset(S initial = 0) noexcept {
+        speed = initial;
+        acceleration = 0;
+    }
+    
+    S Current() const noexcept {
+        return speed;
+    }
     
+    S Acceleration() const noexcept {
+        return acceleration;
+    }
 };
 
+using SpeedRamp = BasicSpeedRamp<Speed>;
+
 namespace controllers {
 
-class MotorInfoIncluded {
+template <typename S> class BasicMotorInfoIncluded {
 protected:
-    MotorInfo info;
+    BasicMotorInfo<S> info;
 public:
     
-    MotorInfoIncluded() = default;
+    BasicMotorInfoIncluded() = default;
     
-    MotorInfoIncluded(const MotorInfo& p_info) noexcept : info(p_info) {}
+    BasicMotorInfoIncluded(const BasicMotorInfo<S>& p_info) noexcept : info(p_info) {}
     
-    virtual MotorInfo Info() const {
+    virtual BasicMotorInfo<S> Info() const {
         return info;
     }
+
+    virtual void setInfo(const BasicMotorInfo<S>& p_info) noexcept {
+        info = p_info;
+    }
 };
 
+using MotorInfoIncluded = BasicMotorInfoIncluded<Speed>;
+
 template <typename T> class InitializationController {
 public:
     virtual util::Error init(T) = 0;
 };
-class SpeedController {
+
+template <typename S> class BasicSpeedController {
 public:
+    using Scalar = S;
 
-    virtual util::Error setSpeed(Speed) = 0;
-    virtual util::Result<Speed> getSpeed() const = 0;
+    virtual util::Error setSpeed(S) = 0;
+    virtual util::Result<S> getSpeed() const = 0;
     
 };
 
-class RangedSpeedController : public MotorInfoIncluded, public SpeedController {
+using SpeedController = BasicSpeedController<Speed>;
+
+// Interface to raw speed mapping of one motor, the state and logic shared by the virtual and the
+// CRTP ranged controllers. The maps and the interface range are cached from the motor info by update.
+template <typename S> class RangedSpeedMapping {
 protected:
-    virtual util::Error setSpeedRaw(Speed) = 0;
-    virtual util::Result<Speed> getSpeedRaw() const = 0;
+    util::LinearMap<S> toRaw;
+    util::LinearMap<S> fromRaw;
+    util::Range<S> interfaceRange;
+
 public:
-    using MotorInfoIncluded::MotorInfoIncluded;
+    RangedSpeedMapping() = default;
+
+    explicit RangedSpeedMapping(const BasicMotorInfo<S>& info) noexcept {
+        update(info);
+    }
+
+    void update(const BasicMotorInfo<S>& info) noexcept {
+        toRaw = util::LinearMap<S>(info.interfaceSpeedRange, info.speedRange, true);
+        fromRaw = util::LinearMap<S>(info.speedRange, info.interfaceSpeedRange);
+        interfaceRange = info.interfaceSpeedRange;
+        if (info.isReversed) {
+            toRaw = toRaw.negatedInput();
+            fromRaw = fromRaw.negatedOutput();
+        }
+    }
+
+    // Maps a speed given in range onto the interface range.
+    S interfaceSpeed(S speed, util::Range<S> range) const noexcept {
+        return interfaceRange.mapValueFromRange(range.restrict(speed), range);
+    }
+
+    S toRawSpeed(S speed) const noexcept {
+        return toRaw(speed);
+    }
+
+    S toRawSpeed(S speed, util::Range<S> range) const noexcept {
+        return toRaw(interfaceSpeed(speed, range));
+    }
+
+    S fromRawSpeed(S raw) const noexcept {
+        return fromRaw(raw);
+    }
+
+    bool inSpeedRange(S speed) const noexcept {
+        return interfaceRange.contains(speed);
+    }
+};
+
+template <typename S> class BasicRangedSpeedController : public BasicMotorInfoIncluded<S>, public BasicSpeedController<S> {
+protected:
+    using BasicMotorInfoIncluded<S>::info;
+
+    RangedSpeedMapping<S> mapping;
+
+    virtual util::Error setSpeedRaw(S) = 0;
+    virtual util::Result<S> getSpeedRaw() const = 0;
+
+    // Must be called after changing info directly, setInfo does it already.
+    void updateMaps() noexcept {
+        mapping.update(info);
+    }
+public:
+    using Scalar = S;
+
+    BasicRangedSpeedController() noexcept {
+        updateMaps();
+    }
+
+    BasicRangedSpeedController(const BasicMotorInfo<S>& p_info) noexcept : BasicMotorInfoIncluded<S>(p_info) {
+        updateMaps();
+    }
+
+    virtual void setInfo(const BasicMotorInfo<S>& p_info) noexcept override {
+        info = p_info;
+        updateMaps();
+    }
     
-    [[nodiscard]] virtual util::Error setSpeed(Speed speed) noexcept override {
-        return setSpeedRaw(info.interfaceSpeedRange.mapValueToRange(info.interfaceSpeedRange.restrict(info.isReversed ? -speed : speed), info.speedRange));
+    S toRawSpeed(S speed) const noexcept {
+        return mapping.toRawSpeed(speed);
+    }
+
+    S toRawSpeed(S speed, util::Range<S> range) const noexcept {
+        return mapping.toRawSpeed(speed, range);
+    }
+
+    [[nodiscard]] virtual util::Error setSpeed(S speed) noexcept override {
+        return setSpeedRaw(mapping.toRawSpeed(speed));
     }
     
-    [[nodiscard]] virtual util::Result<Speed> getSpeed() const noexcept override {
-        util::Result<Speed> rawSpeed = getSpeedRaw();
+    [[nodiscard]] virtual util::Result<S> getSpeed() const noexcept override {
+        util::Result<S> rawSpeed = getSpeedRaw();
         if(rawSpeed) return rawSpeed;
         
-        Speed mapped = info.speedRange.mapValueToRange(rawSpeed(), info.interfaceSpeedRange);
-        
-        return info.isReversed ? -mapped : mapped;
+        return mapping.fromRawSpeed(rawSpeed());
     }
 
-    virtual bool inSpeedRange(Speed speed) const noexcept {
-        return info.interfaceSpeedRange.contains(speed);
+    virtual bool inSpeedRange(S speed) const noexcept {
+        return mapping.inSpeedRange(speed);
     }
     
-    [[nodiscard]] virtual util::Error setSpeedInRange(Speed speed, SpeedRange range) noexcept {
-        return setSpeed(info.interfaceSpeedRange.mapValueFromRange(range.restrict(speed), range));
+    [[nodiscard]] virtual util::Error setSpeedInRange(S speed, util::Range<S> range) noexcept {
+        return setSpeed(mapping.interfaceSpeed(speed, range));
+    }
+};
+
+class RangedSpeedController : public BasicRangedSpeedController<Speed> {
+public:
+    using BasicRangedSpeedController<Speed>::BasicRangedSpeedController;
+};
+
+// Non-virtual counterpart of BasicRangedSpeedController with identical semantics. Derived provides
+// setSpeedRaw(S) and getSpeedRaw() as plain members (make them public or befriend this base), so
+// the map, clamp and driver write are inlined when the concrete controller type is known.
+template <typename Derived, typename S = Speed> class RangedSpeedControllerBase {
+protected:
+    BasicMotorInfo<S> info;
+
+    RangedSpeedMapping<S> mapping;
+
+    Derived& derived() noexcept {
+        return static_cast<Derived&>(*this);
+    }
+
+    const Derived& derived() const noexcept {
+        return static_cast<const Derived&>(*this);
+    }
+
+    void updateMaps() noexcept {
+        mapping.update(info);
+    }
+public:
+    using Scalar = S;
+
+    RangedSpeedControllerBase() noexcept {
+        updateMaps();
+    }
+
+    RangedSpeedControllerBase(const BasicMotorInfo<S>& p_info) noexcept : info(p_info) {
+        updateMaps();
+    }
+
+    const BasicMotorInfo<S>& Info() const noexcept {
+        return info;
+    }
+
+    void setInfo(const BasicMotorInfo<S>& p_info) noexcept {
+        info = p_info;
+        updateMaps();
+    }
+
+    S toRawSpeed(S speed) const noexcept {
+        return mapping.toRawSpeed(speed);
+    }
+
+    S toRawSpeed(S speed, util::Range<S> range) const noexcept {
+        return mapping.toRawSpeed(speed, range);
+    }
+
+    [[nodiscard]] util::Error setSpeed(S speed) noexcept {
+        return derived().setSpeedRaw(mapping.toRawSpeed(speed));
     }
+
+    [[nodiscard]] util::Result<S> getSpeed() const noexcept {
+        util::Result<S> rawSpeed = derived().getSpeedRaw();
+        if(rawSpeed) return rawSpeed;
+
+        return mapping.fromRawSpeed(rawSpeed());
+    }
+
+    bool inSpeedRange(S speed) const noexcept {
+        return mapping.inSpeedRange(speed);
+    }
+
+    [[nodiscard]] util::Error setSpeedInRange(S speed, util::Range<S> range) noexcept {
+        return setSpeed(mapping.interfaceSpeed(speed, range));
+    }
+};
+
+// Exposes a statically dispatched controller through the virtual BasicSpeedController interface,
+// for fleets that mix controller types behind pointers.
+template <typename Controller> class SpeedControllerAdapter : public Controller, public BasicSpeedController<typename Controller::Scalar> {
+public:
+    using Scalar = typename Controller::Scalar;
+    using Controller::Controller;
+
+    [[nodiscard]] util::Error setSpeed(Scalar speed) noexcept override {
+        return Controller::setSpeed(speed);
+    }
+
+    [[nodiscard]] util::Result<Scalar> getSpeed() const noexcept override {
+        return Controller::getSpeed();
+    }
+};
+
+// Scalar of a controller's speed interface, Speed for controllers that do not declare one.
+template <typename Controller, typename = void> struct ControllerScalarTraits {
+    using type = Speed;
+};
+
+template <typename Controller> struct ControllerScalarTraits<Controller, util::VoidT<typename Controller::Scalar>> {
+    using type = typename Controller::Scalar;
+};
+
+template <typename Controller> using ControllerScalar = typename ControllerScalarTraits<Controller>::type;
+
+// Controllers whose driver can update every channel in one bus transaction declare
+//     static util::Error setSpeedsRaw(Controller* controllers, const Scalar* raw, size_t count) noexcept;
+// raw[i] is the already mapped raw speed of controllers[i]. Platform detects it and commits all
+// motors with a single call instead of calling setSpeed per motor.
+template <typename Controller, typename = void> struct BatchSpeedTraits {
+    static constexpr bool enabled = false;
+    using Scalar = Speed;
+};
+
+template <typename Controller> struct BatchSpeedTraits<Controller, util::VoidT<decltype(Controller::setSpeedsRaw(
+    util::declval<Controller*>(), util::declval<const typename Controller::Scalar*>(), util::declval<size_t>()))>> {
+    static constexpr bool enabled = true;
+    using Scalar = typename Controller::Scalar;
 };
 
 } //namespace vislib::motor::controllers
@@ -6,75 +6,494 @@
 
 namespace vislib::platform {
 
-using PlatformMotorConfig = util::Array<motor::MotorInfo>;
-using PlatformMotorSpeeds = util::Array<motor::Speed>;
+// Configs and speed sets are generic over the speed scalar S, so a platform of util::Fixed
+// controllers takes and applies its speeds without touching floating point.
+template<typename S> using BasicPlatformMotorConfig = util::Array<motor::BasicMotorInfo<S>>;
+template<typename S> using BasicPlatformMotorSpeeds = util::Array<S>;
 
-PlatformMotorConfig updateParallelAxisesForMotors(PlatformMotorConfig config, size_t precision) noexcept {
-    for(size_t i = 0; i < config.Size(); i++) {
-        config[i].parallelAxisesAmount = 1;
+template<typename S, size_t N> using BasicStaticMotorConfig = util::StaticVector<motor::BasicMotorInfo<S>, N>;
+template<typename S, size_t N> using BasicStaticMotorSpeeds = util::StaticVector<S, N>;
+
+using PlatformMotorConfig = BasicPlatformMotorConfig<motor::Speed>;
+using PlatformMotorSpeeds = BasicPlatformMotorSpeeds<motor::Speed>;
+
+template<size_t N> using StaticMotorConfig = BasicStaticMotorConfig<motor::Speed, N>;
+template<size_t N> using StaticMotorSpeeds = BasicStaticMotorSpeeds<motor::Speed, N>;
+
+// Motor axes are parallel when their angles modulo 180 degrees lie within half of 10^-precision
+// degrees of each other. Groups chain through neighbours, so sorted angles are split into groups
+// wherever the gap to the next one exceeds the tolerance, including the gap from the largest
+// angle around to the smallest.
+inline double axisTolerance(size_t precision) noexcept {
+    double tolerance = 0.5;
+    for(size_t i = 0; i < precision; i++) {
+        tolerance /= 10;
+    }
+    // Absorbs the representation error of the angles, so 89.4 and 89.9 are half a degree apart.
+    return tolerance * (1 + 1e-9);
+}
+
+inline double axisAngle(double angle) noexcept {
+    const double normalized = fmod(angle, 180.0);
+    if(normalized < 0) {
+        return normalized + 180.0 < 180.0 ? normalized + 180.0 : 0.0;
+    }
+    return normalized;
+}
+
+struct AxisEntry {
+    double angle = 0;
+    size_t index = 0;
+};
+
+struct AxisBucket {
+    double angle = 0;
+    size_t count = 0;
+};
+
+template<typename T> inline bool axisAngleLess(const T& x, const T& y) noexcept {
+    return x.angle < y.angle || (x.angle == y.angle && x.index < y.index);
+}
+
+// Gap from the previous sorted angle to sorted[position], wrapping around at position 0.
+template<typename Sorted> double axisGapBefore(const Sorted& sorted, size_t position) noexcept {
+    if(position == 0) {
+        return sorted[0].angle + 180.0 - sorted[sorted.Size() - 1].angle;
+    }
+    return sorted[position].angle - sorted[position - 1].angle;
+}
+
+// Calls group(first, length) for every group of the sorted angles, positions run from first
+// modulo sorted.Size() since a group may wrap around from the largest angle to the smallest.
+template<typename Sorted, typename Group> void forEachAxisGroup(const Sorted& sorted, double tolerance, const Group& group) noexcept {
+    const size_t size = sorted.Size();
+    if(size == 0) return;
+    
+    size_t start = 0;
+    while(start < size && axisGapBefore(sorted, start) <= tolerance) start++;
+    if(start == size) {
+        group(0, size);
+        return;
+    }
+    
+    for(size_t first = 0; first < size;) {
+        size_t last = first + 1;
+        while(last < size && axisGapBefore(sorted, (start + last) % size) <= tolerance) last++;
+        group((start + first) % size, last - first);
+        first = last;
+    }
+}
+
+template<typename U, typename Alloc> util::Error allocateAxisEntries(util::Array<AxisEntry, Alloc>& entries, const util::Array<U, Alloc>& config) noexcept {
+    entries = util::Array<AxisEntry, Alloc>(config.Size(), config.Allocator());
+    if(entries.Size() != config.Size()) {
+        return util::Error(util::ErrorCode::allocationFailed, "could not allocate motor axis angles");
+    }
+    return util::ErrorCode::success;
+}
+
+template<typename Entries, typename Config> util::Error allocateAxisEntries(Entries& entries, const Config& config) noexcept {
+    return entries.resize(config.Size());
+}
+
+// Caller provided scratch, narrowed to the config size.
+template<typename Config> util::Error allocateAxisEntries(util::Span<AxisEntry>& entries, const Config& config) noexcept {
+    if(entries.Size() < config.Size()) {
+        return util::Error(util::ErrorCode::capacityExceeded, "motor axis scratch buffer is smaller than the motor config");
     }
+    entries = util::Span<AxisEntry>(entries.Data(), config.Size());
+    return util::ErrorCode::success;
+}
+
+template<typename Config, typename Entries> util::Error sortAxisAngles(const Config& config, Entries& entries) noexcept {
+    util::Error err = allocateAxisEntries(entries, config);
+    if(err) return err;
     
     for(size_t i = 0; i < config.Size(); i++) {
-        for(size_t j = i + 1; j < config.Size(); j++) {
-            double diff = round(util::absF(config[i].anglePos - config[j].anglePos) * pow(10, precision));
-            if(diff == 0 || diff == 180) {
-                config[i].parallelAxisesAmount++;
-                config[j].parallelAxisesAmount++;
-            }
+        entries[i].angle = axisAngle(config[i].anglePos);
+        entries[i].index = i;
+    }
+    
+    util::heapSort(entries.Data(), entries.Size(), axisAngleLess<AxisEntry>);
+    return util::ErrorCode::success;
+}
+
+template<typename Config, typename Entries> util::Error countParallelAxises(Config& config, Entries& entries, size_t precision) noexcept {
+    util::Error err = sortAxisAngles(config, entries);
+    if(err) {
+        for(size_t i = 0; i < config.Size(); i++) {
+            config[i].parallelAxisesAmount = 1;
         }
+        return err.withContext("could not count parallel motor axises");
     }
     
+    forEachAxisGroup(entries, axisTolerance(precision), [&](size_t first, size_t length) {
+        for(size_t i = 0; i < length; i++) {
+            config[entries[(first + i) % entries.Size()].index].parallelAxisesAmount = length;
+        }
+    });
+    
+    return util::ErrorCode::success;
+}
+
+template<typename Config> util::Error countParallelAxises(Config& config, size_t precision) noexcept {
+    typename util::RebindStorage<Config, AxisEntry>::type entries;
+    return countParallelAxises(config, entries, precision);
+}
+
+template<typename S> BasicPlatformMotorConfig<S> updateParallelAxisesForMotors(BasicPlatformMotorConfig<S> config, size_t precision) noexcept {
+    (void)countParallelAxises(config, precision);
     return config;
 }
 
-template<typename Controller> class Platform {
+template<typename S, size_t N> BasicStaticMotorConfig<S, N> updateParallelAxisesForMotors(BasicStaticMotorConfig<S, N> config, size_t precision) noexcept {
+    (void)countParallelAxises(config, precision);
+    return config;
+}
+
+// Updates the viewed config in place, only the sort scratch is allocated.
+inline util::Error updateParallelAxisesForMotors(util::Span<motor::MotorInfo> config, size_t precision) noexcept {
+    return countParallelAxises(config, precision);
+}
+
+// Allocation free variant, scratch needs at least config.Size() entries.
+inline util::Error updateParallelAxisesForMotors(util::Span<motor::MotorInfo> config, util::Span<AxisEntry> scratch, size_t precision) noexcept {
+    return countParallelAxises(config, scratch, precision);
+}
+
+// Keeps the sorted distinct axis angles of a configuration with their motor counts, so motors can
+// be added or removed at runtime with O(log n) lookup, a walk over the neighbouring angles of the
+// affected group and one pass over the config instead of a full recount.
+template<typename Storage = util::DynamicArray<AxisBucket>> class ParallelAxisIndex {
 protected:
-    util::Array<Controller> controllers;
+    // Arc of axis angles from low spanning span degrees.
+    struct Group {
+        double low = 0;
+        double span = 0;
+        size_t count = 0;
+        
+        bool contains(double angle) const noexcept {
+            double offset = angle - low;
+            if(offset < 0) offset += 180.0;
+            return offset <= span;
+        }
+    };
+    
+    double tolerance = 0;
+    Storage buckets;
+    
+    static bool bucketLess(const AxisBucket& bucket, double angle) noexcept {
+        return bucket.angle < angle;
+    }
+    
+    size_t find(double angle) const noexcept {
+        return util::lowerBound(buckets.Data(), buckets.Size(), angle, bucketLess);
+    }
+    
+    bool has(size_t position, double angle) const noexcept {
+        return position < buckets.Size() && buckets[position].angle == angle;
+    }
+    
+    size_t previous(size_t position) const noexcept {
+        return position == 0 ? buckets.Size() - 1 : position - 1;
+    }
+    
+    size_t next(size_t position) const noexcept {
+        return position + 1 == buckets.Size() ? 0 : position + 1;
+    }
+    
+    // Group of buckets[position], found by walking out while neighbours are within tolerance.
+    Group groupAt(size_t position) const noexcept {
+        const size_t size = buckets.Size();
+        size_t low = position;
+        size_t high = position;
+        size_t steps = 0;
+        
+        while(steps + 1 < size && axisGapBefore(buckets, low) <= tolerance) {
+            low = previous(low);
+            steps++;
+        }
+        while(steps + 1 < size && axisGapBefore(buckets, next(high)) <= tolerance) {
+            high = next(high);
+            steps++;
+        }
+        
+        Group group;
+        group.low = buckets[low].angle;
+        group.span = buckets[high].angle - buckets[low].angle;
+        if(group.span < 0) group.span += 180.0;
+        
+        for(size_t i = low, n = 0; n <= steps; i = next(i), n++) {
+            group.count += buckets[i].count;
+        }
+        return group;
+    }
+    
+    template<typename Config> void assign(Config& config, const Group& group) const noexcept {
+        for(size_t i = 0; i < config.Size(); i++) {
+            if(group.contains(axisAngle(config[i].anglePos))) {
+                config[i].parallelAxisesAmount = group.count;
+            }
+        }
+    }
     
 public:
+    explicit ParallelAxisIndex(size_t precision = 0) noexcept : tolerance(axisTolerance(precision)) {}
+    
+    // Recounts the whole config in O(n log n) and rebuilds the buckets.
+    template<typename Config> [[nodiscard]] util::Error build(Config& config) noexcept {
+        buckets.clear();
+        
+        typename util::RebindStorage<Config, AxisEntry>::type entries;
+        util::Error err = sortAxisAngles(config, entries);
+        if(err) return err.withContext("could not build parallel axis index");
+        
+        for(size_t i = 0; i < entries.Size(); i++) {
+            if(buckets.Size() > 0 && buckets[buckets.Size() - 1].angle == entries[i].angle) {
+                buckets[buckets.Size() - 1].count++;
+                continue;
+            }
+            err = buckets.push_back(AxisBucket{entries[i].angle, 1});
+            if(err) return err.withContext("could not build parallel axis index");
+        }
+        
+        forEachAxisGroup(entries, tolerance, [&](size_t first, size_t length) {
+            for(size_t i = 0; i < length; i++) {
+                config[entries[(first + i) % entries.Size()].index].parallelAxisesAmount = length;
+            }
+        });
+        
+        return util::ErrorCode::success;
+    }
+    
+    // Accounts for config[index], which was just added to the config or had its angle changed after remove.
+    // The motor may join its angle to neighbouring groups, all of them are updated.
+    template<typename Config> [[nodiscard]] util::Error add(Config& config, size_t index) noexcept {
+        if(index >= config.Size()) {
+            return util::Error(util::ErrorCode::indexOutOfRange, "motor index is out of the config range");
+        }
+        
+        const double angle = axisAngle(config[index].anglePos);
+        const size_t position = find(angle);
+        
+        if(has(position, angle)) {
+            buckets[position].count++;
+        } else {
+            util::Error err = buckets.push_back(AxisBucket{angle, 1});
+            if(err) return err.withContext("could not add motor to parallel axis index");
+            for(size_t i = buckets.Size() - 1; i > position; i--) {
+                util::swap(buckets[i], buckets[i - 1]);
+            }
+        }
+        
+        assign(config, groupAt(position));
+        return util::ErrorCode::success;
+    }
+    
+    // Drops config[index] from its group before it is removed from the config or its angle is changed.
+    // Removing the motor may split its group, both parts are updated.
+    template<typename Config> [[nodiscard]] util::Error remove(Config& config, size_t index) noexcept {
+        if(index >= config.Size()) {
+            return util::Error(util::ErrorCode::indexOutOfRange, "motor index is out of the config range");
+        }
+        
+        const double angle = axisAngle(config[index].anglePos);
+        const size_t position = find(angle);
+        
+        if(!has(position, angle)) {
+            return util::Error(util::ErrorCode::invalidArgument, "motor is not part of the parallel axis index");
+        }
+        
+        if(--buckets[position].count > 0) {
+            assign(config, groupAt(position));
+        } else {
+            for(size_t i = position; i + 1 < buckets.Size(); i++) {
+                util::swap(buckets[i], buckets[i + 1]);
+            }
+            buckets.pop_back();
+            
+            if(buckets.Size() > 0) {
+                const size_t after = position == buckets.Size() ? 0 : position;
+                assign(config, groupAt(previous(after)));
+                assign(config, groupAt(after));
+            }
+        }
+        
+        config[index].parallelAxisesAmount = 1;
+        return util::ErrorCode::success;
+    }
+    
+    // Number of indexed motors in the group angle falls into, 0 when it is not within tolerance of any.
+    size_t amount(double angle) const noexcept {
+        if(buckets.Size() == 0) return 0;
+        
+        const double normalized = axisAngle(angle);
+        size_t after = find(normalized);
+        if(after == buckets.Size()) after = 0;
+        const size_t before = previous(after);
+        
+        double gap = buckets[after].angle - normalized;
+        if(gap < 0) gap += 180.0;
+        if(gap <= tolerance) return groupAt(after).count;
+        
+        gap = normalized - buckets[before].angle;
+        if(gap < 0) gap += 180.0;
+        return gap <= tolerance ? groupAt(before).count : 0;
+    }
+    
+    // Number of distinct axis groups.
+    size_t Size() const noexcept {
+        size_t groups = 0;
+        forEachAxisGroup(buckets, tolerance, [&](size_t, size_t) {
+            groups++;
+        });
+        return groups;
+    }
+};
+
+// Port to controller index map shaped like the controller storage, inline for static platforms.
+template<typename Storage> struct PortIndexStorage;
+
+template<typename C, typename Alloc> struct PortIndexStorage<util::Array<C, Alloc>> {
+    using type = util::FlatMap<ull_t, size_t, util::FlatHash<ull_t>, Alloc>;
+};
 
-    Platform(PlatformMotorConfig configuration, size_t parallelismPrecision = 0) noexcept {
-        configuration = updateParallelAxisesForMotors(configuration, parallelismPrecision);
-        controllers = util::Array<Controller>(configuration.Size());
-        for (size_t i = 0; i < controllers.Size(); i++) {
+template<typename C, size_t N> struct PortIndexStorage<util::StaticVector<C, N>> {
+    using type = util::StaticFlatMap<ull_t, size_t, N>;
+};
+
+template<typename Controller, typename Storage = util::Array<Controller>> class Platform {
+public:
+    using Scalar = motor::controllers::ControllerScalar<Controller>;
+    
+protected:
+    using Batch = motor::controllers::BatchSpeedTraits<Controller>;
+    struct NoRawSpeeds {};
+    using RawSpeeds = util::Conditional<Batch::enabled, typename util::RebindStorage<Storage, typename Batch::Scalar>::type, NoRawSpeeds>;
+
+    Storage controllers;
+    [[no_unique_address]] RawSpeeds rawSpeeds;
+    typename PortIndexStorage<Storage>::type portIndex;
+    // Constructors cannot return errors, init reports this one before touching any motor.
+    util::Error constructionError;
+    
+    template<typename Alloc, typename Config> static util::Error createControllers(util::Array<Controller, Alloc>& storage, const Config& configuration) noexcept {
+        storage = util::Array<Controller, Alloc>(configuration.Size(), storage.Allocator());
+        if (storage.Size() != configuration.Size()) {
+            return util::Error(util::ErrorCode::allocationFailed, "could not allocate platform motor controllers");
+        }
+        for (size_t i = 0; i < storage.Size(); i++) {
             Controller ctrl(configuration[i]);
-            controllers[i] = ctrl;
+            storage[i] = ctrl;
         }
+        return util::ErrorCode::success;
     }
     
-    [[nodiscard]] util::Error setSpeeds(PlatformMotorSpeeds speeds) noexcept {
+    template<size_t N, typename Config> static util::Error createControllers(util::StaticVector<Controller, N>& storage, const Config& configuration) noexcept {
+        if (configuration.Size() > N) {
+            return util::Error(util::ErrorCode::capacityExceeded, "motor config has more motors than the static platform can hold");
+        }
+        for (size_t i = 0; i < configuration.Size(); i++) {
+            util::Result<Controller&> ctrl = storage.emplace_back(configuration[i]);
+            if (ctrl) return ctrl.Err();
+        }
+        return util::ErrorCode::success;
+    }
+    
+    template<typename T, typename U, typename Alloc> static util::Error createRawSpeeds(util::Array<T, Alloc>& buffer, const util::Array<U, Alloc>& storage) noexcept {
+        buffer = util::Array<T, Alloc>(storage.Size(), storage.Allocator());
+        if (buffer.Size() != storage.Size()) {
+            return util::Error(util::ErrorCode::allocationFailed, "could not allocate the raw speeds buffer of the platform");
+        }
+        return util::ErrorCode::success;
+    }
+    
+    template<typename T, typename U, size_t N> static util::Error createRawSpeeds(util::StaticVector<T, N>& buffer, const util::StaticVector<U, N>& storage) noexcept {
+        return buffer.resize(storage.Size());
+    }
+    
+    template<typename S> static util::Error createRawSpeeds(NoRawSpeeds&, const S&) noexcept {
+        return util::ErrorCode::success;
+    }
+    
+    template<typename Map, typename U, typename Alloc> static void createPortIndex(Map& index, const util::Array<U, Alloc>& storage) noexcept {
+        index = Map(storage.Allocator());
+    }
+    
+    template<typename Map, typename U, size_t N> static void createPortIndex(Map&, const util::StaticVector<U, N>&) noexcept {}
+    
+    util::Error commitRawSpeeds() noexcept {
+        util::Error err = Controller::setSpeedsRaw(controllers.Data(), rawSpeeds.Data(), controllers.Size());
+        if(err) {
+            return err.withContext("Could not apply speeds to motor controllers in one transaction");
+        }
+        return util::ErrorCode::success;
+    }
+    
+    template<typename Speeds> util::Error applySpeeds(const Speeds& speeds) noexcept {
+        VISLIB_PROBE(platformSetSpeeds);
         if (speeds.Size() != controllers.Size()) {
             return util::Error(util::ErrorCode::invalidArgument, "Cannot apply speeds set to controller set as there are different amount of them");
         }
         
-        for(size_t i = 0; i < controllers.Size(); i++) {
-            util::Error err = controllers.at(i)().setSpeed(speeds.at(i)());
-            if(err) {
-                return {err.errcode, "Could not apply speed to motor controller, error encountered: " + err.msg};
+        if constexpr (Batch::enabled) {
+            if (rawSpeeds.Size() != controllers.Size()) {
+                return util::Error(util::ErrorCode::allocationFailed, "the raw speeds buffer of the platform was not allocated");
+            }
+            for(size_t i = 0; i < controllers.Size(); i++) {
+                rawSpeeds[i] = controllers[i].toRawSpeed(speeds[i]);
+            }
+            return commitRawSpeeds();
+        } else {
+            for(size_t i = 0; i < controllers.Size(); i++) {
+                util::Error err = controllers[i].setSpeed(speeds[i]);
+                if(err) {
+                    return err.withContext("Could not apply speed to motor controller");
+                }
             }
+            return util::ErrorCode::success;
         }
-        
-        return util::ErrorCode::success;
     }
     
-    [[nodiscard]] util::Error setSpeedsInRanges(PlatformMotorSpeeds speeds, util::Array<motor::SpeedRange> ranges) noexcept {
+    template<typename Speeds, typename Ranges> util::Error applySpeedsInRanges(const Speeds& speeds, const Ranges& ranges) noexcept {
+        VISLIB_PROBE(platformSetSpeedsInRanges);
         if (speeds.Size() != controllers.Size() || speeds.Size() != ranges.Size()) {
             return util::Error(util::ErrorCode::invalidArgument, 
                 "Cannot apply speeds from different ranges set to controller set as there are different amounts of them");
         }
         
-        for(size_t i = 0; i < controllers.Size(); i++) {
-            util::Error err = controllers.at(i)().setSpeedInRange(speeds.at(i)(), ranges[i]);
-            if(err != util::ErrorCode::success) {
-                err.msg = "Could not apply speed to motor controller, error encountered: " + err.msg;
-                return err;
+        if constexpr (Batch::enabled) {
+            if (rawSpeeds.Size() != controllers.Size()) {
+                return util::Error(util::ErrorCode::allocationFailed, "the raw speeds buffer of the platform was not allocated");
             }
+            for(size_t i = 0; i < controllers.Size(); i++) {
+                rawSpeeds[i] = controllers[i].toRawSpeed(speeds[i], ranges[i]);
+            }
+            return commitRawSpeeds();
+        } else {
+            for(size_t i = 0; i < controllers.Size(); i++) {
+                util::Error err = controllers[i].setSpeedInRange(speeds[i], ranges[i]);
+                if(err != util::ErrorCode::success) {
+                    return err.withContext("Could not apply speed to motor controller");
+                }
+            }
+            return util::ErrorCode::success;
         }
-        
-        return util::ErrorCode::success;
     }
     
-    template<typename C> [[nodiscard]] util::Error init(const util::Array<C>& ports) noexcept {
+    template<typename Ports> util::DetailedError initWith(const Ports& ports) noexcept {
+        VISLIB_PROBE(platformInit);
+        
+        if(constructionError) {
+            return {constructionError, util::String::concat("failed initializing the platform motors, the platform could not be constructed from its config: ",
+                constructionError.msg)};
+        }
+        
+        portIndex.clear();
+        util::Error reserved = portIndex.reserve(controllers.Size());
+        if(reserved) {
+            return {reserved, util::String("failed initializing the platform motors, could not allocate the port lookup table")};
+        }
         
         for(size_t i = 0; i < controllers.Size(); i++) {
             
@@ -82,38 +501,420 @@ public:
             auto p = ports.at(i);
             
             if (t.isError()) {
-                return util::Error(util::ErrorCode::initFailed, 
-                    "failed initializing one of the platform motors, invalid motor controller with index" 
-                    + util::to_string(i) + ": " + t.Err().msg);
+                return {util::Error(util::ErrorCode::initFailed, "failed initializing one of the platform motors, invalid motor controller"), 
+                    util::String::concat("failed initializing one of the platform motors, invalid motor controller with index ",
+                    util::to_string(i), ": ", t.Err().msg)};
             }
             
             if (p.isError()) {
-                return util::Error(util::ErrorCode::invalidArgument, 
-                    "failed initializing one of the platform motors, invalid port array was given at index " 
-                    + util::to_string(i) + " : " + p.Err().msg);
+                return {util::Error(util::ErrorCode::invalidArgument, "failed initializing one of the platform motors, invalid port array was given"), 
+                    util::String::concat("failed initializing one of the platform motors, invalid port array was given at index ",
+                    util::to_string(i), " : ", p.Err().msg)};
             }
             
-            auto e = t().init(p());
+            util::Error e = t().init(p());
             
             if(e) {
-                return util::Error(util::ErrorCode::initFailed, 
-                    "failed initializing one of the platform motors, failed motor controller initialization at index "
-                    + util::to_string(i) + " and port with value " + util::to_string(static_cast<unsigned long long>(p())) + ": " + e.msg);
+                return {util::Error(util::ErrorCode::initFailed, "failed initializing one of the platform motors, failed motor controller initialization"), 
+                    util::String::concat("failed initializing one of the platform motors, failed motor controller initialization at index ",
+                    util::to_string(i), " and port with value ", util::to_string(static_cast<unsigned long long>(p())), ": ", e.msg)};
             }
+            
+            // Capacity was reserved above, so this cannot fail. Motors sharing a port resolve to the first one.
+            const ull_t port = static_cast<ull_t>(p());
+            if(!portIndex.contains(port)) (void)portIndex.insert(port, i);
         }
         
         return util::ErrorCode::success;
     }
     
-    const util::Array<Controller>& Controllers() const noexcept {
+public:
+
+    // The config may use another scalar than the controllers, it is converted once per motor here.
+    template<typename S> Platform(BasicPlatformMotorConfig<S> configuration, size_t parallelismPrecision = 0) noexcept {
+        (void)countParallelAxises(configuration, parallelismPrecision);
+        constructionError = createControllers(controllers, configuration);
+        if (!constructionError) constructionError = createRawSpeeds(rawSpeeds, controllers);
+        createPortIndex(portIndex, controllers);
+    }
+    
+    template<typename S, size_t N> Platform(BasicStaticMotorConfig<S, N> configuration, size_t parallelismPrecision = 0) noexcept {
+        (void)countParallelAxises(configuration, parallelismPrecision);
+        constructionError = createControllers(controllers, configuration);
+        if (!constructionError) constructionError = createRawSpeeds(rawSpeeds, controllers);
+        createPortIndex(portIndex, controllers);
+    }
+    
+    // Speeds are in the controller scalar, they reach the controllers without any conversion.
+    [[nodiscard]] util::Error setSpeeds(const BasicPlatformMotorSpeeds<Scalar>& speeds) noexcept {
+        return applySpeeds(speeds);
+    }
+    
+    [[nodiscard]] util::Error setSpeeds(util::Span<const Scalar> speeds) noexcept {
+        return applySpeeds(speeds);
+    }
+    
+    template<size_t N> [[nodiscard]] util::Error setSpeeds(const BasicStaticMotorSpeeds<Scalar, N>& speeds) noexcept {
+        return applySpeeds(speeds);
+    }
+    
+    [[nodiscard]] util::Error setSpeedsInRanges(const BasicPlatformMotorSpeeds<Scalar>& speeds, const util::Array<util::Range<Scalar>>& ranges) noexcept {
+        return applySpeedsInRanges(speeds, ranges);
+    }
+    
+    [[nodiscard]] util::Error setSpeedsInRanges(util::Span<const Scalar> speeds, util::Span<const util::Range<Scalar>> ranges) noexcept {
+        return applySpeedsInRanges(speeds, ranges);
+    }
+    
+    template<size_t N> [[nodiscard]] util::Error setSpeedsInRanges(const BasicStaticMotorSpeeds<Scalar, N>& speeds, const util::StaticVector<util::Range<Scalar>, N>& ranges) noexcept {
+        return applySpeedsInRanges(speeds, ranges);
+    }
+    
+    template<typename C> [[nodiscard]] util::DetailedError init(const util::Array<C>& ports) noexcept {
+        return initWith(ports);
+    }
+    
+    template<typename C, size_t N> [[nodiscard]] util::DetailedError init(const util::StaticVector<C, N>& ports) noexcept {
+        return initWith(ports);
+    }
+    
+    // Opt-in ramping stage: advances ramp (a BasicSpeedRampBank created from the same config, one
+    // entry per motor) by dt towards speeds and applies the ramped speeds. The ramp keeps its state
+    // between calls, so call this once per control tick instead of setSpeeds.
+    template<typename Ramp> [[nodiscard]] util::Error setSpeedsRamped(util::Span<const Scalar> speeds, Ramp& ramp, Scalar dt) noexcept {
+        if (ramp.Size() != controllers.Size()) {
+            return util::Error(util::ErrorCode::invalidArgument, "speed ramp bank size does not match the controller set");
+        }
+        
+        util::Error err = ramp.step(speeds, dt);
+        if (err) {
+            return err.withContext("Could not ramp platform speeds");
+        }
+        return applySpeeds(ramp.Speeds());
+    }
+    
+    // O(1) lookup of the motor initialized on port, for dispatching incoming bus messages.
+    template<typename Port> [[nodiscard]] util::Result<size_t> indexOfPort(const Port& port) const noexcept {
+        const size_t *index = portIndex.find(static_cast<ull_t>(port));
+        if(index == nullptr) {
+            return util::Error(util::ErrorCode::keyNotFound, "no platform motor was initialized on this port");
+        }
+        return *index;
+    }
+    
+    template<typename Port> [[nodiscard]] util::Result<Controller&> controllerOnPort(const Port& port) noexcept {
+        const size_t *index = portIndex.find(static_cast<ull_t>(port));
+        if(index == nullptr) {
+            return util::Error(util::ErrorCode::keyNotFound, "no platform motor was initialized on this port");
+        }
+        return controllers[*index];
+    }
+    
+    const Storage& Controllers() const noexcept {
         return controllers;
     }
     
+    // Error of building the controllers from the config, also returned by init.
+    util::Error ConstructionError() const noexcept {
+        return constructionError;
+    }
+    
 };
 
+template<typename Controller, size_t N> using StaticPlatform = Platform<Controller, util::StaticVector<Controller, N>>;
+
+// Platform over motors driven by different controller types. The controllers live inline in a tuple
+// and are constructed directly from their configuration, every loop is unrolled at compile time.
+template<typename... ControllerTypes> class HeterogeneousPlatform {
+public:
+    static constexpr size_t N = sizeof...(ControllerTypes);
+    
+protected:
+    using Indices = util::MakeIndexSequence<N>;
+    
+    util::Tuple<ControllerTypes...> controllers;
+    util::StaticFlatMap<ull_t, size_t, N> portIndex;
+    // A config with fewer motors than controllers leaves the platform unusable, init and the speed
+    // setters return this error instead of driving default configured motors.
+    util::Error constructionError;
+    
+    static util::Error checkConfig(const StaticMotorConfig<N>& configuration) noexcept {
+        if (configuration.Size() != N) {
+            return util::Error(util::ErrorCode::invalidArgument, "motor config size does not match the heterogeneous platform controller count");
+        }
+        return util::ErrorCode::success;
+    }
+    
+    // Missing entries are only default constructed to build the tuple, constructionError is set then.
+    template<size_t... I> HeterogeneousPlatform(const StaticMotorConfig<N>& configuration, util::IndexSequence<I...>) noexcept
+    : controllers((I < configuration.Size() ? configuration[I] : motor::MotorInfo())...), constructionError(checkConfig(configuration)) {}
+    
+    template<typename Speeds, size_t... I> util::Error applySpeeds(const Speeds& speeds, util::IndexSequence<I...>) noexcept {
+        VISLIB_PROBE(platformSetSpeeds);
+        if (constructionError) {
+            return constructionError;
+        }
+        if (speeds.Size() != N) {
+            return util::Error(util::ErrorCode::invalidArgument, "Cannot apply speeds set to controller set as there are different amount of them");
+        }
+        
+        util::Error err = util::ErrorCode::success;
+        (void)((!(err = util::get<I>(controllers).setSpeed(speeds[I]))) && ...);
+        if(err) {
+            return err.withContext("Could not apply speed to motor controller");
+        }
+        
+        return util::ErrorCode::success;
+    }
+    
+    template<typename Speeds, typename Ranges, size_t... I> util::Error applySpeedsInRanges(const Speeds& speeds, const Ranges& ranges, util::IndexSequence<I...>) noexcept {
+        VISLIB_PROBE(platformSetSpeedsInRanges);
+        if (constructionError) {
+            return constructionError;
+        }
+        if (speeds.Size() != N || ranges.Size() != N) {
+            return util::Error(util::ErrorCode::invalidArgument, 
+                "Cannot apply speeds from different ranges set to controller set as there are different amounts of them");
+        }
+        
+        util::Error err = util::ErrorCode::success;
+        (void)((!(err = util::get<I>(controllers).setSpeedInRange(speeds[I], ranges[I]))) && ...);
+        if(err) {
+            return err.withContext("Could not apply speed to motor controller");
+        }
+        
+        return util::ErrorCode::success;
+    }
+    
+    template<size_t I, typename Port> util::DetailedError initOne(const Port& port) noexcept {
+        util::Error e = util::get<I>(controllers).init(port);
+        if(e) {
+            return {util::Error(util::ErrorCode::initFailed, "failed initializing one of the platform motors, failed motor controller initialization"), 
+                util::String::concat("failed initializing one of the platform motors, failed motor controller initialization at index ",
+                util::to_string(static_cast<unsigned long long>(I)), ": ", e.msg)};
+        }
+        const ull_t key = static_cast<ull_t>(port);
+        if(!portIndex.contains(key)) (void)portIndex.insert(key, I);
+        return util::ErrorCode::success;
+    }
+    
+    template<typename... Ports, size_t... I> util::DetailedError initEach(util::IndexSequence<I...>, const Ports&... ports) noexcept {
+        VISLIB_PROBE(platformInit);
+        if (constructionError) {
+            return {constructionError, util::String("failed initializing the platform motors, the motor config does not have one entry per controller")};
+        }
+        portIndex.clear();
+        util::DetailedError result = util::ErrorCode::success;
+        (void)((!(result = initOne<I>(ports)).err) && ...);
+        return result;
+    }
+    
+    template<typename Ports, size_t... I> util::DetailedError initFrom(const Ports& ports, util::IndexSequence<I...>) noexcept {
+        if (ports.Size() != N) {
+            return {util::Error(util::ErrorCode::invalidArgument, "failed initializing one of the platform motors, invalid port array was given"), 
+                util::String::concat("failed initializing the platform motors, port array has ", util::to_string(static_cast<unsigned long long>(ports.Size())),
+                " entries for ", util::to_string(static_cast<unsigned long long>(N)), " motors")};
+        }
+        return initEach(Indices(), ports[I]...);
+    }
+    
+public:
+    
+    HeterogeneousPlatform(StaticMotorConfig<N> configuration, size_t parallelismPrecision = 0) noexcept
+    : HeterogeneousPlatform(updateParallelAxisesForMotors(configuration, parallelismPrecision), Indices()) {}
+    
+    [[nodiscard]] util::Error setSpeeds(const PlatformMotorSpeeds& speeds) noexcept {
+        return applySpeeds(speeds, Indices());
+    }
+    
+    [[nodiscard]] util::Error setSpeeds(util::Span<const motor::Speed> speeds) noexcept {
+        return applySpeeds(speeds, Indices());
+    }
+    
+    [[nodiscard]] util::Error setSpeeds(const StaticMotorSpeeds<N>& speeds) noexcept {
+        return applySpeeds(speeds, Indices());
+    }
+    
+    [[nodiscard]] util::Error setSpeedsInRanges(const PlatformMotorSpeeds& speeds, const util::Array<motor::SpeedRange>& ranges) noexcept {
+        return applySpeedsInRanges(speeds, ranges, Indices());
+    }
+    
+    [[nodiscard]] util::Error setSpeedsInRanges(util::Span<const motor::Speed> speeds, util::Span<const motor::SpeedRange> ranges) noexcept {
+        return applySpeedsInRanges(speeds, ranges, Indices());
+    }
+    
+    [[nodiscard]] util::Error setSpeedsInRanges(const StaticMotorSpeeds<N>& speeds, const util::StaticVector<motor::SpeedRange, N>& ranges) noexcept {
+        return applySpeedsInRanges(speeds, ranges, Indices());
+    }
+    
+    // One port per motor, each may have the port type of its own controller.
+    template<typename... Ports> [[nodiscard]] util::DetailedError init(const Ports&... ports) noexcept {
+        static_assert(sizeof...(Ports) == N, "init needs one port per motor controller");
+        return initEach(Indices(), ports...);
+    }
+    
+    template<typename C> [[nodiscard]] util::DetailedError init(const util::Array<C>& ports) noexcept {
+        return initFrom(ports, Indices());
+    }
+    
+    template<typename C, size_t M> [[nodiscard]] util::DetailedError init(const util::StaticVector<C, M>& ports) noexcept {
+        return initFrom(ports, Indices());
+    }
+    
+    const util::Tuple<ControllerTypes...>& Controllers() const noexcept {
+        return controllers;
+    }
+    
+    template<size_t I> const auto& Controller() const noexcept {
+        return util::get<I>(controllers);
+    }
+    
+    util::Error ConstructionError() const noexcept {
+        return constructionError;
+    }
+    
+    template<typename Port> [[nodiscard]] util::Result<size_t> indexOfPort(const Port& port) const noexcept {
+        const size_t *index = portIndex.find(static_cast<ull_t>(port));
+        if(index == nullptr) {
+            return util::Error(util::ErrorCode::keyNotFound, "no platform motor was initialized on this port");
+        }
+        return *index;
+    }
+    
+    static constexpr size_t Size() noexcept {
+        return N;
+    }
+    
+};
+
+// Ramping state of all motors of a platform in structure of arrays layout, so one step over every
+// motor is a single vectorizable loop (GCC needs -fno-math-errno to vectorize the sqrt of the jerk
+// limit). Limits come from maxAcceleration and maxJerk in the config.
+template<typename S, typename Storage = util::Array<S>> class BasicSpeedRampBank {
+protected:
+    Storage speeds;
+    Storage accelerations;
+    Storage maxAccelerations;
+    Storage maxJerks;
+    
+    template<typename Alloc> static util::Error allocate(util::Array<S, Alloc>& storage, size_t count) noexcept {
+        storage = util::Array<S, Alloc>(count, storage.Allocator());
+        if(storage.Size() != count) {
+            return util::Error(util::ErrorCode::allocationFailed, "could not allocate speed ramp bank");
+        }
+        return util::ErrorCode::success;
+    }
+    
+    template<size_t N> static util::Error allocate(util::StaticVector<S, N>& storage, size_t count) noexcept {
+        return storage.resize(count);
+    }
+    
+    // The bank owns the state arrays, targets come from the caller and may alias anything but them.
+    static void stepAll(S *VISLIB_RESTRICT speed, S *VISLIB_RESTRICT acceleration, const S *VISLIB_RESTRICT maxAcceleration,
+        const S *VISLIB_RESTRICT maxJerk, const S *targets, size_t count, S dt, S invDt) noexcept {
+        for(size_t i = 0; i < count; i++) {
+            motor::rampStep(speed[i], acceleration[i], targets[i], maxAcceleration[i], maxJerk[i], dt, invDt);
+        }
+    }
+    
+public:
+    BasicSpeedRampBank() = default;
+    
+    template<typename Config> [[nodiscard]] static util::Result<BasicSpeedRampBank> create(const Config& config) noexcept {
+        BasicSpeedRampBank bank;
+        
+        util::Error err = allocate(bank.speeds, config.Size());
+        if(!err) err = allocate(bank.accelerations, config.Size());
+        if(!err) err = allocate(bank.maxAccelerations, config.Size());
+        if(!err) err = allocate(bank.maxJerks, config.Size());
+        if(err) return err;
+        
+        for(size_t i = 0; i < config.Size(); i++) {
+            if(config[i].maxAcceleration < 0 || config[i].maxJerk < 0) {
+                return util::Error(util::ErrorCode::invalidArgument, "acceleration and jerk limits cannot be negative in motor config");
+            }
+            
+            bank.speeds[i] = 0;
+            bank.accelerations[i] = 0;
+            bank.maxAccelerations[i] = static_cast<S>(config[i].maxAcceleration);
+            bank.maxJerks[i] = static_cast<S>(config[i].maxJerk);
+        }
+        
+        return bank;
+    }
+    
+    // Advances every motor by dt towards targets, the ramped speeds are in Speeds() afterwards.
+    [[nodiscard]] util::Error step(const S *targets, S dt) noexcept {
+        if(!(dt > static_cast<S>(0))) {
+            return util::Error(util::ErrorCode::invalidArgument, "ramp time step must be positive");
+        }
+        
+        stepAll(speeds.Data(), accelerations.Data(), maxAccelerations.Data(), maxJerks.Data(), targets, speeds.Size(), dt, static_cast<S>(1) / dt);
+        return util::ErrorCode::success;
+    }
+    
+    // Same, and copies the ramped speeds to out, which may alias targets.
+    [[nodiscard]] util::Error step(const S *targets, S dt, S *out) noexcept {
+        util::Error err = step(targets, dt);
+        if(err) return err;
+        
+        for(size_t i = 0; i < speeds.Size(); i++) {
+            out[i] = speeds[i];
+        }
+        return util::ErrorCode::success;
+    }
+    
+    [[nodiscard]] util::Error step(util::Span<const S> targets, S dt) noexcept {
+        if(targets.Size() != speeds.Size()) {
+            return util::Error(util::ErrorCode::invalidArgument, "speeds buffer size does not match the speed ramp bank");
+        }
+        return step(targets.Data(), dt);
+    }
+    
+    template<typename Speeds> [[nodiscard]] util::Error step(const Speeds& targets, S dt, Speeds& out) noexcept {
+        if(targets.Size() != speeds.Size() || out.Size() != speeds.Size()) {
+            return util::Error(util::ErrorCode::invalidArgument, "speeds buffer size does not match the speed ramp bank");
+        }
+        return step(targets.Data(), dt, out.Data());
+    }
+    
+    [[nodiscard]] util::Error step(util::Span<const S> targets, S dt, util::Span<S> out) noexcept {
+        if(targets.Size() != speeds.Size() || out.Size() != speeds.Size()) {
+            return util::Error(util::ErrorCode::invalidArgument, "speeds buffer size does not match the speed ramp bank");
+        }
+        return step(targets.Data(), dt, out.Data());
+    }
+    
+    void reset() noexcept {
+        for(size_t i = 0; i < speeds.Size(); i++) {
+            speeds[i] = 0;
+            accelerations[i] = 0;
+        }
+    }
+    
+    size_t Size() const noexcept {
+        return speeds.Size();
+    }
+    
+    const Storage& Speeds() const noexcept {
+        return speeds;
+    }
+    
+    const Storage& Accelerations() const noexcept {
+        return accelerations;
+    }
+};
+
+using SpeedRampBank = BasicSpeedRampBank<motor::Speed>;
+template<size_t N, typename S = motor::Speed> using StaticSpeedRampBank = BasicSpeedRampBank<S, util::StaticVector<S, N>>;
+
 namespace calculators {
     
-    [[nodiscard]] util::Result<motor::Speed> calculateMotorLinearSpeed(motor::MotorInfo info, double angle, motor::Speed speed) noexcept {
+    // Trig selects the cosine kernel, see util::TrigExact, util::TrigPolynomial and util::TrigTable.
+    // Speeds are in the scalar S of the config. The geometry in the motor info is double, so these
+    // per call calculators convert it for every motor; a Fixed pipeline without floating point at
+    // runtime uses BasicKinematicsPlan with util::TrigFixedTable instead.
+    template<typename Trig = util::TrigExact, typename S> [[nodiscard]] util::Result<S> calculateMotorLinearSpeed(const motor::BasicMotorInfo<S>& info, double angle, util::TypeIdentity<S> speed) noexcept {
         if(info.parallelAxisesAmount == 0) {
             return util::Error(util::ErrorCode::invalidArgument, "amount of motors with parallel movement axises cannot be zero in motor config");
         }
@@ -122,24 +923,323 @@ namespace calculators {
             return util::Error(util::ErrorCode::outOfRange, "the given speed is not in the configured motor interface speed range");
         }
         
-        return util::cosDegrees(angle - info.anglePos) * speed / info.parallelAxisesAmount / info.wheelR;
+        const S cosine = static_cast<S>(util::cosDegrees<Trig>(static_cast<typename Trig::Scalar>(angle - info.anglePos)));
+        return cosine * speed / static_cast<S>(info.parallelAxisesAmount) / static_cast<S>(info.wheelR);
         
     }
     
-    [[nodiscard]] util::Result<PlatformMotorSpeeds> calculatePlatformLinearSpeeds(PlatformMotorConfig config, double angle, motor::Speed speed) noexcept {
-        PlatformMotorSpeeds speeds(config.Size());
+    // Writes into a caller buffer with one speed per motor, nothing is copied or allocated.
+    template<typename Trig = util::TrigExact, typename S> [[nodiscard]] util::Error calculatePlatformLinearSpeeds(util::Span<const motor::BasicMotorInfo<util::TypeIdentity<S>>> config,
+        double angle, S speed, util::Span<util::TypeIdentity<S>> out) noexcept {
+        VISLIB_PROBE(linearSpeeds);
+        if(out.Size() != config.Size()) {
+            return util::Error(util::ErrorCode::invalidArgument, "output speeds buffer size does not match the motor config");
+        }
         
-        for(size_t i = 0; i < speeds.Size(); i++) {
+        for(size_t i = 0; i < config.Size(); i++) {
             
-            util::Result<motor::Speed> t = calculateMotorLinearSpeed(config[i], angle, speed);
+            util::Result<S> t = calculateMotorLinearSpeed<Trig>(config[i], angle, speed);
             if(t) return t.Err();
             
-            speeds[i] = t;
+            out[i] = t;
         }
         
+        return util::ErrorCode::success;
+    }
+    
+    template<typename Trig = util::TrigExact, typename S> [[nodiscard]] util::Result<BasicPlatformMotorSpeeds<S>> calculatePlatformLinearSpeeds(const BasicPlatformMotorConfig<S>& config,
+        double angle, util::TypeIdentity<S> speed) noexcept {
+        BasicPlatformMotorSpeeds<S> speeds(config.Size());
+        
+        util::Error err = calculatePlatformLinearSpeeds<Trig, S>(config, angle, speed, speeds);
+        if(err) return err;
+        
         return speeds;
     }
     
+    template<typename Trig = util::TrigExact, typename S, size_t N> [[nodiscard]] util::Result<BasicStaticMotorSpeeds<S, N>> calculatePlatformLinearSpeeds(const BasicStaticMotorConfig<S, N>& config,
+        double angle, util::TypeIdentity<S> speed) noexcept {
+        VISLIB_PROBE(linearSpeeds);
+        BasicStaticMotorSpeeds<S, N> speeds;
+        
+        for(size_t i = 0; i < config.Size(); i++) {
+            
+            util::Result<S> t = calculateMotorLinearSpeed<Trig>(config[i], angle, speed);
+            if(t) return t.Err();
+            
+            (void)speeds.push_back(t);
+        }
+        
+        return speeds;
+    }
+    
+    template<typename S> struct BasicMotionCommand {
+        S angle = 0;
+        S speed = 0;
+    };
+    
+    using MotionCommand = BasicMotionCommand<motor::Speed>;
+    
+    template<typename S> struct BasicKinematicsTerm {
+        using Scalar = S;
+        
+        S cosBasis = 1;
+        S sinBasis = 0;
+        S scale = 1;
+    };
+    
+    using KinematicsTerm = BasicKinematicsTerm<motor::Speed>;
+    
+    // The scalar comes from the term type of Storage. Terms are computed in double once by create,
+    // compute and computeBatch then run in the scalar and in Trig, so with Fixed terms and
+    // util::TrigFixedTable the hot path is integer only.
+    template<typename Storage, typename Trig = util::TrigExact> class BasicKinematicsPlan {
+    public:
+        using Term = util::ContainerElement<Storage>;
+        using Scalar = typename Term::Scalar;
+        
+    protected:
+        static constexpr size_t BATCH_BLOCK = 64;
+        
+        Storage terms;
+        util::Range<Scalar> speedRange;
+        
+        template<typename Alloc> static util::Error allocateTerms(util::Array<Term, Alloc>& storage, size_t count) noexcept {
+            storage = util::Array<Term, Alloc>(count, storage.Allocator());
+            if(storage.Size() != count) {
+                return util::Error(util::ErrorCode::allocationFailed, "could not allocate kinematics plan");
+            }
+            return util::ErrorCode::success;
+        }
+        
+        template<size_t N> static util::Error allocateTerms(util::StaticVector<Term, N>& storage, size_t count) noexcept {
+            return storage.resize(count);
+        }
+        
+    public:
+        BasicKinematicsPlan() = default;
+        
+        template<typename Config> [[nodiscard]] static util::Result<BasicKinematicsPlan> create(const Config& config) noexcept {
+            BasicKinematicsPlan plan;
+            
+            util::Error err = allocateTerms(plan.terms, config.Size());
+            if(err) return err;
+            
+            for(size_t i = 0; i < config.Size(); i++) {
+                const auto& info = config[i];
+                
+                if(info.parallelAxisesAmount == 0) {
+                    return util::Error(util::ErrorCode::invalidArgument, "amount of motors with parallel movement axises cannot be zero in motor config");
+                }
+                
+                if(info.wheelR == 0) {
+                    return util::Error(util::ErrorCode::zeroDivision, "wheel radius cannot be zero in motor config");
+                }
+                
+                Term& term = plan.terms[i];
+                term.cosBasis = static_cast<Scalar>(util::cosDegrees(info.anglePos));
+                term.sinBasis = static_cast<Scalar>(util::sinDegrees(info.anglePos));
+                term.scale = static_cast<Scalar>(1.0 / (info.parallelAxisesAmount * info.wheelR));
+                
+                const util::Range<Scalar> range(info.interfaceSpeedRange);
+                if(i == 0) {
+                    plan.speedRange = range;
+                } else {
+                    plan.speedRange.lowest = util::maxF(plan.speedRange.lowest, range.lowest);
+                    plan.speedRange.highest = util::minF(plan.speedRange.highest, range.highest);
+                }
+            }
+            
+            return plan;
+        }
+        
+        [[nodiscard]] util::Error compute(Scalar angle, Scalar speed, Scalar *out) const noexcept {
+            VISLIB_PROBE(kinematicsCompute);
+            if(!speedRange.contains(speed)) {
+                return util::Error(util::ErrorCode::outOfRange, "the given speed is not in the configured motor interface speed range");
+            }
+            
+            typename Trig::Scalar s = 0, c = 0;
+            util::sincosDegrees<Trig>(static_cast<typename Trig::Scalar>(angle), s, c);
+            
+            const Scalar vx = static_cast<Scalar>(c) * speed;
+            const Scalar vy = static_cast<Scalar>(s) * speed;
+            const size_t count = terms.Size();
+            const Term *t = terms.Data();
+            
+            for(size_t i = 0; i < count; i++) {
+                out[i] = (vx * t[i].cosBasis + vy * t[i].sinBasis) * t[i].scale;
+            }
+            
+            return util::ErrorCode::success;
+        }
+        
+        template<typename Speeds> [[nodiscard]] util::Error compute(Scalar angle, Scalar speed, Speeds& out) const noexcept {
+            if(out.Size() != terms.Size()) {
+                return util::Error(util::ErrorCode::invalidArgument, "output speeds buffer size does not match the kinematics plan");
+            }
+            return compute(angle, speed, out.Data());
+        }
+        
+        [[nodiscard]] util::Error compute(Scalar angle, Scalar speed, util::Span<Scalar> out) const noexcept {
+            if(out.Size() != terms.Size()) {
+                return util::Error(util::ErrorCode::invalidArgument, "output speeds buffer size does not match the kinematics plan");
+            }
+            return compute(angle, speed, out.Data());
+        }
+        
+        [[nodiscard]] util::Error computeBatch(const BasicMotionCommand<Scalar> *commands, size_t count, Scalar *out) const noexcept {
+            VISLIB_PROBE(kinematicsBatch);
+            for(size_t c = 0; c < count; c++) {
+                if(!speedRange.contains(commands[c].speed)) {
+                    return util::Error(util::ErrorCode::outOfRange, "one of the batched speeds is not in the configured motor interface speed range");
+                }
+            }
+            
+            const size_t motors = terms.Size();
+            const Term *t = terms.Data();
+            Scalar vx[BATCH_BLOCK];
+            Scalar vy[BATCH_BLOCK];
+            
+            for(size_t base = 0; base < count; base += BATCH_BLOCK) {
+                const size_t n = util::minF(BATCH_BLOCK, count - base);
+                const BasicMotionCommand<Scalar> *block = commands + base;
+                
+                for(size_t c = 0; c < n; c++) {
+                    typename Trig::Scalar s = 0, k = 0;
+                    util::sincosDegrees<Trig>(static_cast<typename Trig::Scalar>(block[c].angle), s, k);
+                    vx[c] = static_cast<Scalar>(k) * block[c].speed;
+                    vy[c] = static_cast<Scalar>(s) * block[c].speed;
+                }
+                
+                for(size_t m = 0; m < motors; m++) {
+                    const Scalar cosBasis = t[m].cosBasis * t[m].scale;
+                    const Scalar sinBasis = t[m].sinBasis * t[m].scale;
+                    Scalar *row = out + m * count + base;
+                    
+                    for(size_t c = 0; c < n; c++) {
+                        row[c] = vx[c] * cosBasis + vy[c] * sinBasis;
+                    }
+                }
+            }
+            
+            return util::ErrorCode::success;
+        }
+        
+        template<typename Speeds> [[nodiscard]] util::Error computeBatch(const BasicMotionCommand<Scalar> *commands, size_t count, Speeds& out) const noexcept {
+            if(out.Size() != terms.Size() * count) {
+                return util::Error(util::ErrorCode::invalidArgument, "output speeds table size does not match motors times commands");
+            }
+            return computeBatch(commands, count, out.Data());
+        }
+        
+        [[nodiscard]] util::Error computeBatch(util::Span<const BasicMotionCommand<Scalar>> commands, util::Span<Scalar> out) const noexcept {
+            if(out.Size() != terms.Size() * commands.Size()) {
+                return util::Error(util::ErrorCode::invalidArgument, "output speeds table size does not match motors times commands");
+            }
+            return computeBatch(commands.Data(), commands.Size(), out.Data());
+        }
+        
+        static size_t batchIndex(size_t motorIndex, size_t commandIndex, size_t commandCount) noexcept {
+            return motorIndex * commandCount + commandIndex;
+        }
+        
+        size_t Size() const noexcept {
+            return terms.Size();
+        }
+        
+        const util::Range<Scalar>& SpeedRange() const noexcept {
+            return speedRange;
+        }
+        
+        const Storage& Terms() const noexcept {
+            return terms;
+        }
+    };
+    
+    using KinematicsPlan = BasicKinematicsPlan<util::Array<KinematicsTerm>>;
+    template<size_t N, typename Trig = util::TrigExact, typename S = motor::Speed> using StaticKinematicsPlan = BasicKinematicsPlan<util::StaticVector<BasicKinematicsTerm<S>, N>, Trig>;
+    
+    // Kinematics of a Fixed controller platform, no floating point after create.
+    template<typename S> using FixedKinematicsPlan = BasicKinematicsPlan<util::Array<BasicKinematicsTerm<S>>, util::TrigFixedTable<S>>;
+    
+    using PlatformTwist = util::Vec<double, 3>;
+    
+    template<size_t N, typename Trig = util::TrigExact> class HolonomicKinematics {
+    protected:
+        util::Matrix<double, N, 3> inverseMatrix;
+        util::Matrix<double, 3, N> forwardMatrix;
+        bool forwardValid = false;
+        
+    public:
+        HolonomicKinematics() = default;
+        
+        template<typename Config> [[nodiscard]] static util::Result<HolonomicKinematics> create(const Config& config) noexcept {
+            if(config.Size() != N) {
+                return util::Error(util::ErrorCode::invalidArgument, "motor config size does not match the kinematics dimension");
+            }
+            
+            HolonomicKinematics kinematics;
+            
+            for(size_t i = 0; i < N; i++) {
+                const motor::MotorInfo& info = config[i];
+                
+                if(info.parallelAxisesAmount == 0) {
+                    return util::Error(util::ErrorCode::invalidArgument, "amount of motors with parallel movement axises cannot be zero in motor config");
+                }
+                
+                if(info.wheelR == 0) {
+                    return util::Error(util::ErrorCode::zeroDivision, "wheel radius cannot be zero in motor config");
+                }
+                
+                // Parallel wheels share the whole twist, rotation included, as in the linear calculators.
+                const double share = 1.0 / (info.parallelAxisesAmount * info.wheelR);
+                kinematics.inverseMatrix(i, 0) = util::cosDegrees(info.anglePos) * share;
+                kinematics.inverseMatrix(i, 1) = util::sinDegrees(info.anglePos) * share;
+                kinematics.inverseMatrix(i, 2) = info.distance * share;
+            }
+            
+            if constexpr (N >= 3) {
+                util::Result<util::Matrix<double, 3, N>> forward = util::pseudoInverse(kinematics.inverseMatrix);
+                if(forward.isOK()) {
+                    kinematics.forwardMatrix = forward.Value();
+                    kinematics.forwardValid = true;
+                }
+            }
+            
+            return kinematics;
+        }
+        
+        util::Vec<motor::Speed, N> wheelSpeeds(const PlatformTwist& twist) const noexcept {
+            return inverseMatrix * twist;
+        }
+        
+        util::Vec<motor::Speed, N> wheelSpeeds(double angle, motor::Speed speed, double angularSpeed = 0) const noexcept {
+            typename Trig::Scalar s = 0, c = 0;
+            util::sincosDegrees<Trig>(static_cast<typename Trig::Scalar>(angle), s, c);
+            return inverseMatrix * PlatformTwist(c * speed, s * speed, angularSpeed);
+        }
+        
+        [[nodiscard]] util::Result<PlatformTwist> twist(const util::Vec<motor::Speed, N>& wheelSpeeds) const noexcept {
+            if(!forwardValid) {
+                return util::Error(util::ErrorCode::singularMatrix, "platform twist cannot be recovered from this motor layout");
+            }
+            return forwardMatrix * wheelSpeeds;
+        }
+        
+        const util::Matrix<double, N, 3>& InverseMatrix() const noexcept {
+            return inverseMatrix;
+        }
+        
+        const util::Matrix<double, 3, N>& ForwardMatrix() const noexcept {
+            return forwardMatrix;
+        }
+        
+        bool hasForward() const noexcept {
+            return forwardValid;
+        }
+    };
+    
 } // namespace vislib::platform::calculators
 
 } //namespace vislib::platform
@@ -2,6 +2,7 @@
 
 #include "types.hpp"
 #include "errordef.hpp"
+#include "memory.hpp"
 
 namespace vislib::util {
 
@@ -48,14 +49,14 @@ public:
 
     [[nodiscard]] Result<T&> at(size_t index) noexcept {
         if (index >= SIZE) {
-            return {ErrorCode::indexOutOfRange, "Index out of range in 'defined array' element access"};
+            return Error(ErrorCode::indexOutOfRange, "Index out of range in 'defined array' element access");
         }
         return data[index];
     }
 
     [[nodiscard]] Result<const T&> at(size_t index) const noexcept {
         if (index >= SIZE) {
-            return {ErrorCode::indexOutOfRange, "Index out of range in 'defined array' element access"};
+            return Error(ErrorCode::indexOutOfRange, "Index out of range in 'defined array' element access");
         }
         return data[index];
     }
@@ -64,82 +65,177 @@ public:
         return SIZE;
     }
     
+    constexpr size_t Size() const noexcept {
+        return SIZE;
+    }
+    
     constexpr bool empty() const noexcept {
         return SIZE == 0;
     }
 
+    T* Data() noexcept {
+        return data;
+    }
+    
+    const T* Data() const noexcept {
+        return data;
+    }
+
+};
+
+// True when a view of To elements may point at From elements: same type, never dropping const.
+template<typename From, typename To> struct IsSpanCompatible {
+    static constexpr bool value = IsSame<RemoveConst<From>, RemoveConst<To>>::value && (IsConst<To>::value || !IsConst<From>::value);
+};
+
+template<typename Container> using ContainerElement = typename RemoveReference<decltype(*declval<Container&>().Data())>::type;
+
+// Non-owning view of size contiguous elements, constructible from anything with Data() and Size()
+// (Array, DynamicArray, StaticVector, DefinedArray, another Span) and from C arrays. Copying a span
+// never copies the elements, the viewed storage has to outlive it.
+template<typename T> class Span {
+protected:
+    T *data = nullptr;
+    size_t size = 0;
+
+public:
+    using Type = T;
+
+    constexpr Span() = default;
+
+    constexpr Span(T *p_data, size_t p_size) noexcept : data(p_data), size(p_size) {}
+
+    template<typename U, size_t N, typename = EnableIf<IsSpanCompatible<U, T>::value>> constexpr Span(U (&p_data)[N]) noexcept : data(p_data), size(N) {}
+
+    template<typename Container, typename = EnableIf<IsSpanCompatible<ContainerElement<Container>, T>::value>>
+    Span(Container& container) noexcept : data(container.Data()), size(container.Size()) {}
+
+    template<typename Container, typename = EnableIf<IsSpanCompatible<ContainerElement<const Container>, T>::value>>
+    Span(const Container& container) noexcept : data(container.Data()), size(container.Size()) {}
+
+    constexpr T& operator[](size_t index) const noexcept {
+        return data[index];
+    }
+
+    [[nodiscard]] Result<T&> at(size_t index) const noexcept {
+        if (index >= size) {
+            return Error(ErrorCode::indexOutOfRange, "index out of range in span element access");
+        }
+        return data[index];
+    }
+
+    [[nodiscard]] Result<Span> subspan(size_t offset, size_t count) const noexcept {
+        if (offset > size || count > size - offset) {
+            return Error(ErrorCode::indexOutOfRange, "subspan exceeds the viewed range");
+        }
+        return Span(data + offset, count);
+    }
+
+    constexpr T* Data() const noexcept {
+        return data;
+    }
+
+    constexpr size_t Size() const noexcept {
+        return size;
+    }
+
+    constexpr bool empty() const noexcept {
+        return size == 0;
+    }
 };
 
-template<typename T> class Array {
+template<typename T> using ArrayView = Span<const T>;
+
+template<typename T, typename Alloc = HeapAllocator> class Array {
 protected:
     size_t size = 0;
     T *data = nullptr;
+    [[no_unique_address]] Alloc alloc;
+
+    void acquire(size_t count) noexcept {
+        size = 0;
+        data = nullptr;
+        if (count == 0) return;
+
+        data = static_cast<T*>(alloc.allocate(sizeof(T) * count, alignof(T)));
+        if (data == nullptr) return;
+
+        for(size_t i = 0; i < count; i++) new (data + i) T;
+        size = count;
+    }
+
+    void acquireCopy(const T* src, size_t count) noexcept {
+        size = 0;
+        data = nullptr;
+        if (count == 0 || src == nullptr) return;
+
+        data = static_cast<T*>(alloc.allocate(sizeof(T) * count, alignof(T)));
+        if (data == nullptr) return;
+
+        for(size_t i = 0; i < count; i++) new (data + i) T(src[i]);
+        size = count;
+    }
+
+    void release() noexcept {
+        if (data == nullptr) return;
+        for(size_t i = 0; i < size; i++) data[i].~T();
+        alloc.deallocate(data, sizeof(T) * size, alignof(T));
+        data = nullptr;
+        size = 0;
+    }
 
 public:
     Array() = default;
 
-    Array(size_t p_size) noexcept : size(p_size), data(new T[size]) { }
+    explicit Array(const Alloc& p_alloc) noexcept : alloc(p_alloc) {}
 
-    template<size_t N> explicit Array(const T (&p_data)[N]) noexcept : size(N), data(new T[size]) {
-        for(size_t i = 0; i < size; i++) data[i] = p_data[i];
+    Array(size_t p_size, const Alloc& p_alloc = Alloc()) noexcept : alloc(p_alloc) {
+        acquire(p_size);
     }
 
-    Array(const T p_data[], size_t p_size) noexcept : size(p_size), data(new T[size]) {
-        for(size_t i = 0; i < size; i++) data[i] = p_data[i];
+    template<size_t N> explicit Array(const T (&p_data)[N], const Alloc& p_alloc = Alloc()) noexcept : alloc(p_alloc) {
+        acquireCopy(p_data, N);
     }
 
-    Array(const Array<T>& other) noexcept : size(0), data(nullptr) {
-        if (other.size > 0 && other.data != nullptr) {
-            data = new T[other.size];
-            if (data) {
-                size = other.size;
-                for(size_t i = 0; i < size; i++) data[i] = other.data[i];
-            }
-        }
+    Array(const T p_data[], size_t p_size, const Alloc& p_alloc = Alloc()) noexcept : alloc(p_alloc) {
+        acquireCopy(p_data, p_size);
+    }
+
+    Array(const Array& other) noexcept : alloc(other.alloc) {
+        acquireCopy(other.data, other.size);
     }
 
-    Array(Array<T>&& other) noexcept : size(other.size), data(other.data) {
+    Array(Array&& other) noexcept : size(other.size), data(other.data), alloc(other.alloc) {
         other.size = 0;
         other.data = nullptr;
     }
 
     ~Array() noexcept {
-        delete [] data;
+        release();
     }
 
-    Array<T>& operator=(const Array<T>& other) noexcept {
+    Array& operator=(const Array& other) noexcept {
         if (this == &other) return *this;
 
-        T* newData = nullptr;
-        size_t newSize = 0;
-
-        if (other.size > 0 && other.data != nullptr) {
-            newData = new T[other.size];
-            if (newData) {
-                newSize = other.size;
-                for(size_t i = 0; i < newSize; i++) newData[i] = other.data[i];
-            }
-        }
-
-        delete[] data;
-        data = newData;
-        size = newSize;
+        release();
+        acquireCopy(other.data, other.size);
 
         return *this;
     }
 
-    Array<T>& operator=(Array<T>&& other) noexcept {
+    Array& operator=(Array&& other) noexcept {
         if (this != &other) {
-            delete[] data;
+            release();
             data = other.data;
             size = other.size;
+            alloc = other.alloc;
             other.data = nullptr;
             other.size = 0;
         }
         return *this;
     }
 
-    bool operator==(const Array<T>& other) const noexcept {
+    bool operator==(const Array& other) const noexcept {
         if (size != other.size) return false;
         if(data == other.data && data == nullptr) return true;
         if((data == nullptr || other.data == nullptr) && data != other.data) return false;
@@ -187,9 +283,7 @@ public:
     }
     
     void clear() noexcept {
-        delete [] data;
-        size = 0;
-        data = nullptr;
+        release();
     }
 
     T* Data() noexcept {
@@ -200,179 +294,1250 @@ public:
         return data;
     }
 
-    Array<T> operator+(const Array<T>& other) const noexcept {
-        Array<T> newArr;
-        newArr.size = size + other.size;
-        newArr.data = new T[newArr.size];
-        for(size_t i = 0; i < size; i++) newArr.data[i] = data[i];
-        for(size_t i = 0; i < other.size; i++) newArr.data[size + i] = other.data[i];
+    const Alloc& Allocator() const noexcept {
+        return alloc;
+    }
+
+    Array operator+(const Array& other) const noexcept {
+        Array newArr(alloc);
+        size_t total = size + other.size;
+        if (total == 0) return newArr;
+
+        newArr.data = static_cast<T*>(newArr.alloc.allocate(sizeof(T) * total, alignof(T)));
+        if (newArr.data == nullptr) return newArr;
+
+        for(size_t i = 0; i < size; i++) new (newArr.data + i) T(data[i]);
+        for(size_t i = 0; i < other.size; i++) new (newArr.data + size + i) T(other.data[i]);
+        newArr.size = total;
         return newArr;
     }
 
 };
 
-class String : public Array<char> {
-private:
-    static size_t c_strlen(const char* str) noexcept {
-        if (!str) return 0;
-        const char* ptr = str;
-        while (*ptr) ptr++;
-        return (size_t)(ptr - str);
+template<typename T, typename Alloc = HeapAllocator> class DynamicArray {
+protected:
+    size_t size = 0;
+    size_t capacity = 0;
+    T *data = nullptr;
+    [[no_unique_address]] Alloc alloc;
+
+    T* allocate(size_t count) noexcept {
+        return static_cast<T*>(alloc.allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t count) noexcept {
+        if (ptr == nullptr) return;
+        alloc.deallocate(ptr, sizeof(T) * count, alignof(T));
+    }
+
+    static void destroyRange(T* first, size_t count) noexcept {
+        for(size_t i = 0; i < count; i++) first[i].~T();
+    }
+
+    static void relocateRange(T* dst, T* src, size_t count) noexcept {
+        for(size_t i = 0; i < count; i++) {
+            new (dst + i) T(util::move(src[i]));
+            src[i].~T();
+        }
     }
 
-    size_t char_capacity() const noexcept {
-        size_t s = this->Size();
-        return s == 0 ? 0 : s - 1;
+    size_t grownCapacity(size_t required) const noexcept {
+        size_t newCapacity = capacity == 0 ? 4 : capacity * 2;
+        return newCapacity < required ? required : newCapacity;
     }
 
-    void ensure_null_terminated() noexcept {
-        if (this->Size() == 0) return;
-        this->Data()[ this->Size() - 1 ] = '\0';
+    void copyFrom(const T* src, size_t count) noexcept {
+        if (count == 0 || reserve(count)) return;
+        for(size_t i = 0; i < count; i++) new (data + i) T(src[i]);
+        size = count;
     }
 
 public:
-    String() noexcept : Array<char>(1) {
-        this->Data()[0] = '\0';
+    DynamicArray() = default;
+
+    explicit DynamicArray(const Alloc& p_alloc) noexcept : alloc(p_alloc) {}
+
+    template<size_t N> explicit DynamicArray(const T (&p_data)[N], const Alloc& p_alloc = Alloc()) noexcept : alloc(p_alloc) {
+        copyFrom(p_data, N);
     }
 
-    String(const char* cstr) noexcept : Array<char>(c_strlen(cstr) + 1)  {
-        size_t len = c_strlen(cstr);
-        size_t cap = char_capacity();
-        if (len > cap) len = cap;
-        for (size_t i = 0; i < len; ++i) this->Data()[i] = cstr[i];
-        ensure_null_terminated();
+    DynamicArray(const T p_data[], size_t p_size, const Alloc& p_alloc = Alloc()) noexcept : alloc(p_alloc) {
+        copyFrom(p_data, p_size);
     }
 
-    String(const char* cstr, size_t length) noexcept : Array<char>(length + 1) {
-        size_t cap = char_capacity();
-        size_t copy_len = length <= cap ? length : cap;
-        for (size_t i = 0; i < copy_len; ++i) this->Data()[i] = cstr[i];
-        ensure_null_terminated();
+    DynamicArray(const DynamicArray& other) noexcept : alloc(other.alloc) {
+        copyFrom(other.data, other.size);
     }
 
-    String(size_t count, char ch) noexcept : Array<char>(count + 1) {
-        size_t cap = char_capacity();
-        size_t n = count <= cap ? count : cap;
-        for (size_t i = 0; i < n; ++i) this->Data()[i] = ch;
-        ensure_null_terminated();
+    DynamicArray(DynamicArray&& other) noexcept : size(other.size), capacity(other.capacity), data(other.data), alloc(other.alloc) {
+        other.size = 0;
+        other.capacity = 0;
+        other.data = nullptr;
     }
 
-    using Array<char>::Array;
-    using Array<char>::operator=;
+    ~DynamicArray() noexcept {
+        destroyRange(data, size);
+        deallocate(data, capacity);
+    }
 
-    const char* c_str() const noexcept {
-        if (this->Size() == 0) return "";
-        return this->Data();
+    DynamicArray& operator=(const DynamicArray& other) noexcept {
+        if (this == &other) return *this;
+        clear();
+        copyFrom(other.data, other.size);
+        return *this;
     }
 
-    size_t length() const noexcept {
-        if (this->Size() == 0) return 0;
+    DynamicArray& operator=(DynamicArray&& other) noexcept {
+        if (this != &other) {
+            destroyRange(data, size);
+            deallocate(data, capacity);
+            data = other.data;
+            size = other.size;
+            capacity = other.capacity;
+            alloc = other.alloc;
+            other.data = nullptr;
+            other.size = 0;
+            other.capacity = 0;
+        }
+        return *this;
+    }
+
+    T& operator[](size_t index) noexcept {
+        return data[index];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return data[index];
+    }
+
+    [[nodiscard]] Result<T&> at(size_t index) noexcept {
+        if (size == 0) {
+            return Error(ErrorCode::emptyArray, "could not access data of an empty dynamic array");
+        }
+        if (index >= size) {
+            return Error(ErrorCode::indexOutOfRange, "index out of range in dynamic array element access");
+        }
+        return data[index];
+    }
+
+    [[nodiscard]] Result<const T&> at(size_t index) const noexcept {
+        if (size == 0) {
+            return Error(ErrorCode::emptyArray, "could not access data of an empty dynamic array");
+        }
+        if (index >= size) {
+            return Error(ErrorCode::indexOutOfRange, "index out of range in dynamic array element access");
+        }
+        return data[index];
+    }
 
-        const char* d = this->Data();
-        for (size_t i = 0; i < char_capacity(); ++i) {
-            if (d[i] == '\0') return i;
+    Error reserve(size_t newCapacity) noexcept {
+        if (newCapacity <= capacity) return ErrorCode::success;
+
+        T* newData = allocate(newCapacity);
+        if (newData == nullptr) {
+            return Error(ErrorCode::allocationFailed, "could not reserve dynamic array storage");
         }
 
-        return char_capacity();
+        relocateRange(newData, data, size);
+        deallocate(data, capacity);
+        data = newData;
+        capacity = newCapacity;
+
+        return ErrorCode::success;
     }
 
-    String operator+(const String& other) const noexcept {
-        size_t l1 = this->length();
-        size_t l2 = other.length();
-        size_t out_len = l1 + l2;
-        String result(out_len + 1, '\0');
+    Error shrink_to_fit() noexcept {
+        if (size == capacity) return ErrorCode::success;
+
+        if (size == 0) {
+            deallocate(data, capacity);
+            data = nullptr;
+            capacity = 0;
+            return ErrorCode::success;
+        }
 
-        for (size_t i = 0; i < l1 && i < result.char_capacity(); ++i)
-            result.Data()[i] = this->Data()[i];
+        T* newData = allocate(size);
+        if (newData == nullptr) {
+            return Error(ErrorCode::allocationFailed, "could not shrink dynamic array storage");
+        }
 
-        size_t pos = l1;
-        for (size_t j = 0; j < l2 && pos < result.char_capacity(); ++j, ++pos)
-            result.Data()[pos] = other.Data()[j];
-        result.ensure_null_terminated();
-        return result;
+        relocateRange(newData, data, size);
+        deallocate(data, capacity);
+        data = newData;
+        capacity = size;
+
+        return ErrorCode::success;
+    }
+
+    template<typename... Args> Result<T&> emplace_back(Args&&... args) noexcept {
+        if (size < capacity) {
+            new (data + size) T(util::forward<Args>(args)...);
+            return data[size++];
+        }
+
+        size_t newCapacity = grownCapacity(size + 1);
+        T* newData = allocate(newCapacity);
+        if (newData == nullptr) {
+            return Error(ErrorCode::allocationFailed, "could not grow dynamic array storage");
+        }
+
+        new (newData + size) T(util::forward<Args>(args)...);
+        relocateRange(newData, data, size);
+        deallocate(data, capacity);
+        data = newData;
+        capacity = newCapacity;
+
+        return data[size++];
+    }
+
+    Error push_back(const T& value) noexcept {
+        Result<T&> element = emplace_back(value);
+        if (element) return element.Err();
+        return ErrorCode::success;
+    }
+
+    Error push_back(T&& value) noexcept {
+        Result<T&> element = emplace_back(util::move(value));
+        if (element) return element.Err();
+        return ErrorCode::success;
+    }
+
+    void pop_back() noexcept {
+        if (size == 0) return;
+        data[--size].~T();
+    }
+
+    Error resize(size_t newSize) noexcept {
+        if (newSize < size) {
+            destroyRange(data + newSize, size - newSize);
+            size = newSize;
+            return ErrorCode::success;
+        }
+
+        Error err = reserve(newSize);
+        if (err) return err;
+
+        for(size_t i = size; i < newSize; i++) new (data + i) T();
+        size = newSize;
+
+        return ErrorCode::success;
+    }
+
+    void clear() noexcept {
+        destroyRange(data, size);
+        size = 0;
+    }
+
+    size_t Size() const noexcept {
+        return size;
+    }
+
+    size_t Capacity() const noexcept {
+        return capacity;
+    }
+
+    bool empty() const noexcept {
+        return size == 0;
+    }
+
+    T* Data() noexcept {
+        return data;
+    }
+
+    const T* Data() const noexcept {
+        return data;
+    }
+
+    const Alloc& Allocator() const noexcept {
+        return alloc;
+    }
+
+};
+
+template<typename T, size_t CAPACITY> class StaticVector {
+protected:
+    size_t size = 0;
+    alignas(T) unsigned char storage[sizeof(T) * (CAPACITY == 0 ? 1 : CAPACITY)];
+
+    T* slots() noexcept {
+        return reinterpret_cast<T*>(storage);
+    }
+
+    const T* slots() const noexcept {
+        return reinterpret_cast<const T*>(storage);
+    }
+
+    void copyFrom(const T* src, size_t count) noexcept {
+        for(size_t i = 0; i < count; i++) new (slots() + i) T(src[i]);
+        size = count;
+    }
+
+public:
+    StaticVector() noexcept {}
+
+    template<size_t N> explicit StaticVector(const T (&p_data)[N]) noexcept {
+        static_assert(N <= CAPACITY, "Array size must not exceed StaticVector capacity");
+        copyFrom(p_data, N);
+    }
+
+    // Copies p_size elements, capacityExceeded when they do not fit instead of dropping the tail.
+    [[nodiscard]] static Result<StaticVector> create(const T p_data[], size_t p_size) noexcept {
+        if (p_size > CAPACITY) {
+            return Error(ErrorCode::capacityExceeded, "data does not fit the static vector capacity");
+        }
+
+        StaticVector vector;
+        vector.copyFrom(p_data, p_size);
+        return vector;
+    }
+
+    StaticVector(const StaticVector<T, CAPACITY>& other) noexcept {
+        copyFrom(other.slots(), other.size);
+    }
+
+    StaticVector(StaticVector<T, CAPACITY>&& other) noexcept {
+        for(size_t i = 0; i < other.size; i++) new (slots() + i) T(util::move(other.slots()[i]));
+        size = other.size;
+        other.clear();
     }
 
-    String operator+(const char* other) const {
-        String rhs(other);
-        return *this + rhs;
+    ~StaticVector() noexcept {
+        clear();
     }
 
-    String& operator+=(const String& other) noexcept {
-        size_t l1 = this->length();
-        size_t l2 = other.length();
-        size_t cap = char_capacity();
-        size_t copy_len = (l1 + l2 <= cap) ? l2 : (cap > l1 ? cap - l1 : 0);
-        for (size_t i = 0; i < copy_len; ++i) this->Data()[l1 + i] = other.Data()[i];
-        ensure_null_terminated();
+    StaticVector<T, CAPACITY>& operator=(const StaticVector<T, CAPACITY>& other) noexcept {
+        if (this != &other) {
+            clear();
+            copyFrom(other.slots(), other.size);
+        }
         return *this;
     }
 
-    String& operator+=(const char* other) noexcept {
-        String rhs(other);
-        *this += rhs;
+    StaticVector<T, CAPACITY>& operator=(StaticVector<T, CAPACITY>&& other) noexcept {
+        if (this != &other) {
+            clear();
+            for(size_t i = 0; i < other.size; i++) new (slots() + i) T(util::move(other.slots()[i]));
+            size = other.size;
+            other.clear();
+        }
         return *this;
     }
 
-    bool operator==(const String& other) const noexcept {
-        size_t l1 = length();
-        size_t l2 = other.length();
-        if (l1 != l2) return false;
-        for (size_t i = 0; i < l1; ++i) if (this->Data()[i] != other.Data()[i]) return false;
-        return true;
+    T& operator[](size_t index) noexcept {
+        return slots()[index];
     }
 
-    bool operator==(const char* other) const noexcept {
-        size_t other_len = c_strlen(other);
-        size_t l = length();
-        if (l != other_len) return false;
-        for (size_t i = 0; i < l; ++i) if (this->Data()[i] != other[i]) return false;
-        return true;
+    const T& operator[](size_t index) const noexcept {
+        return slots()[index];
     }
 
-    bool operator!=(const String& other) const noexcept {
-        return !(*this == other);
+    [[nodiscard]] Result<T&> at(size_t index) noexcept {
+        if (size == 0) {
+            return Error(ErrorCode::emptyArray, "could not access data of an empty static vector");
+        }
+        if (index >= size) {
+            return Error(ErrorCode::indexOutOfRange, "index out of range in static vector element access");
+        }
+        return slots()[index];
     }
-    
-    bool operator!=(const char* other) const noexcept {
-        return !(*this == other);
+
+    [[nodiscard]] Result<const T&> at(size_t index) const noexcept {
+        if (size == 0) {
+            return Error(ErrorCode::emptyArray, "could not access data of an empty static vector");
+        }
+        if (index >= size) {
+            return Error(ErrorCode::indexOutOfRange, "index out of range in static vector element access");
+        }
+        return slots()[index];
     }
-};
 
-inline String operator+(const char* str1, const String& str2) noexcept {
-    String temp(str1);
-    return temp + str2;
-}
+    template<typename... Args> Result<T&> emplace_back(Args&&... args) noexcept {
+        if (size >= CAPACITY) {
+            return Error(ErrorCode::capacityExceeded, "static vector is full");
+        }
+        new (slots() + size) T(util::forward<Args>(args)...);
+        return slots()[size++];
+    }
 
-inline bool operator==(const char* lhs, const String& rhs) noexcept {
-    return rhs == lhs;
-}
-inline bool operator!=(const char* lhs, const String& rhs) noexcept {
-    return !(rhs == lhs);
-}
+    Error push_back(const T& value) noexcept {
+        Result<T&> element = emplace_back(value);
+        if (element) return element.Err();
+        return ErrorCode::success;
+    }
 
-inline String to_string(unsigned long long value) noexcept {
-    if (value == 0) return String("0");
-    char buf[32];
-    size_t idx = 0;
-    unsigned long long v = value;
-    while (v > 0 && idx < sizeof(buf)-1) {
-        buf[idx++] = char('0' + (v % 10));
-        v /= 10;
+    Error push_back(T&& value) noexcept {
+        Result<T&> element = emplace_back(util::move(value));
+        if (element) return element.Err();
+        return ErrorCode::success;
     }
 
-    String s(idx + 1, '\0');
-    for (size_t i = 0; i < idx; i++) s[i] = buf[idx - 1 - i];
-    s[idx] = '\0';
-    return s;
-}
+    void pop_back() noexcept {
+        if (size == 0) return;
+        slots()[--size].~T();
+    }
+
+    Error resize(size_t newSize) noexcept {
+        if (newSize > CAPACITY) {
+            return Error(ErrorCode::capacityExceeded, "could not resize static vector past its capacity");
+        }
+
+        while (size > newSize) pop_back();
+        for(; size < newSize; size++) new (slots() + size) T();
 
-inline String to_string(long long value) noexcept {
-    if (value < 0) {
-        unsigned long long uv = (unsigned long long)(-value);
-        String s = String("-") + to_string(uv);
-        return s;
+        return ErrorCode::success;
     }
-    return to_string((unsigned long long)value);
-}
 
-} //namespace vislib::util
+    void clear() noexcept {
+        while (size > 0) pop_back();
+    }
+
+    size_t Size() const noexcept {
+        return size;
+    }
+
+    static constexpr size_t Capacity() noexcept {
+        return CAPACITY;
+    }
+
+    bool empty() const noexcept {
+        return size == 0;
+    }
+
+    bool full() const noexcept {
+        return size == CAPACITY;
+    }
+
+    T* Data() noexcept {
+        return slots();
+    }
+
+    const T* Data() const noexcept {
+        return slots();
+    }
+
+};
+
+// Wait-free single producer, single consumer queue of fixed power of two capacity. Exactly one
+// thread (or ISR) may push and exactly one may pop. Indices run freely and are word sized so plain
+// loads and stores are atomic on 32 bit MCUs too. Producer and consumer state live on separate
+// cache lines, each side keeps a cached copy of the other index to avoid touching its line.
+template<typename T, size_t CAPACITY> class SpscRingBuffer {
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "SpscRingBuffer capacity must be a power of two");
+
+protected:
+    static constexpr ul_t MASK = static_cast<ul_t>(CAPACITY - 1);
+
+    alignas(CACHE_LINE_SIZE) ul_t tail = 0;
+    ul_t cachedHead = 0;
+
+    alignas(CACHE_LINE_SIZE) ul_t head = 0;
+    ul_t cachedTail = 0;
+
+    alignas(CACHE_LINE_SIZE) alignas(T) unsigned char storage[sizeof(T) * CAPACITY];
+
+    T* slots() noexcept {
+        return reinterpret_cast<T*>(storage);
+    }
+
+    // Free slots seen by the producer, refreshing the cached head only when needed.
+    size_t writable(ul_t t, size_t wanted) noexcept {
+        size_t available = CAPACITY - static_cast<size_t>(t - cachedHead);
+        if (available < wanted) {
+            cachedHead = atomicLoadAcquire(&head);
+            available = CAPACITY - static_cast<size_t>(t - cachedHead);
+        }
+        return available;
+    }
+
+    // Filled slots seen by the consumer, refreshing the cached tail only when needed.
+    size_t readable(ul_t h, size_t wanted) noexcept {
+        size_t filled = static_cast<size_t>(cachedTail - h);
+        if (filled < wanted) {
+            cachedTail = atomicLoadAcquire(&tail);
+            filled = static_cast<size_t>(cachedTail - h);
+        }
+        return filled;
+    }
+
+public:
+    SpscRingBuffer() noexcept {}
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    ~SpscRingBuffer() noexcept {
+        for(ul_t h = head; h != tail; h++) {
+            slots()[h & MASK].~T();
+        }
+    }
+
+    // Producer side.
+    [[nodiscard]] Error try_push(const T& value) noexcept {
+        const ul_t t = tail;
+        if (writable(t, 1) == 0) {
+            return Error(ErrorCode::capacityExceeded, "ring buffer is full");
+        }
+        new (slots() + (t & MASK)) T(value);
+        atomicStoreRelease(&tail, t + 1);
+        return ErrorCode::success;
+    }
+
+    // Producer side, pushes as many of items as fit and publishes them at once. Returns the amount pushed.
+    size_t try_push(const T *items, size_t count) noexcept {
+        const ul_t t = tail;
+        const size_t available = writable(t, count);
+        const size_t n = count < available ? count : available;
+        for(size_t i = 0; i < n; i++) {
+            new (slots() + ((t + i) & MASK)) T(items[i]);
+        }
+        if (n > 0) atomicStoreRelease(&tail, static_cast<ul_t>(t + n));
+        return n;
+    }
+
+    // Consumer side.
+    [[nodiscard]] Error try_pop(T& out) noexcept {
+        const ul_t h = head;
+        if (readable(h, 1) == 0) {
+            return Error(ErrorCode::emptyArray, "ring buffer is empty");
+        }
+        T *slot = slots() + (h & MASK);
+        out = util::move(*slot);
+        slot->~T();
+        atomicStoreRelease(&head, h + 1);
+        return ErrorCode::success;
+    }
+
+    // Consumer side, pops up to count items into out and releases their slots at once. Returns the amount popped.
+    size_t try_pop(T *out, size_t count) noexcept {
+        const ul_t h = head;
+        const size_t filled = readable(h, count);
+        const size_t n = count < filled ? count : filled;
+        for(size_t i = 0; i < n; i++) {
+            T *slot = slots() + ((h + i) & MASK);
+            out[i] = util::move(*slot);
+            slot->~T();
+        }
+        if (n > 0) atomicStoreRelease(&head, static_cast<ul_t>(h + n));
+        return n;
+    }
+
+    // Snapshot of the amount of queued items, exact only when called from one of the two sides.
+    size_t Size() const noexcept {
+        return static_cast<size_t>(atomicLoadAcquire(&tail) - atomicLoadAcquire(&head));
+    }
+
+    bool empty() const noexcept {
+        return Size() == 0;
+    }
+
+    static constexpr size_t Capacity() noexcept {
+        return CAPACITY;
+    }
+};
+
+// Same kind of container as Storage, holding T instead, e.g. a per-motor buffer shaped like the controller storage.
+template<typename Storage, typename T> struct RebindStorage;
+
+template<typename U, typename Alloc, typename T> struct RebindStorage<Array<U, Alloc>, T> {
+    using type = Array<T, Alloc>;
+};
+
+template<typename U, size_t CAPACITY, typename T> struct RebindStorage<StaticVector<U, CAPACITY>, T> {
+    using type = StaticVector<T, CAPACITY>;
+};
+
+template<typename U, typename Alloc, typename T> struct RebindStorage<DynamicArray<U, Alloc>, T> {
+    using type = DynamicArray<T, Alloc>;
+};
+
+// A span owns nothing to rebind, per-element scratch for it lives on the heap.
+template<typename U, typename T> struct RebindStorage<Span<U>, T> {
+    using type = DynamicArray<T>;
+};
+
+template<typename T, typename Less> void siftDown(T *data, size_t root, size_t count, const Less& less) noexcept {
+    while(true) {
+        size_t child = root * 2 + 1;
+        if(child >= count) return;
+        if(child + 1 < count && less(data[child], data[child + 1])) child++;
+        if(!less(data[root], data[child])) return;
+        swap(data[root], data[child]);
+        root = child;
+    }
+}
+
+// In place O(n log n) sort without extra memory, not stable.
+template<typename T, typename Less> void heapSort(T *data, size_t count, const Less& less) noexcept {
+    if(count < 2) return;
+    for(size_t i = count / 2; i > 0; i--) {
+        siftDown(data, i - 1, count, less);
+    }
+    for(size_t end = count - 1; end > 0; end--) {
+        swap(data[0], data[end]);
+        siftDown(data, 0, end, less);
+    }
+}
+
+// Index of the first element not less than value in a sorted range.
+template<typename T, typename V, typename Less> size_t lowerBound(const T *data, size_t count, const V& value, const Less& less) noexcept {
+    size_t first = 0;
+    while(count > 0) {
+        size_t half = count / 2;
+        if(less(data[first + half], value)) {
+            first += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    return first;
+}
+
+template<size_t I, typename T> struct TupleLeaf {
+    T value;
+
+    TupleLeaf() = default;
+
+    template<typename A> explicit TupleLeaf(const A& arg) noexcept : value(arg) {}
+};
+
+template<typename Indices, typename... Ts> class TupleImpl;
+
+template<size_t... I, typename... Ts> class TupleImpl<IndexSequence<I...>, Ts...> : public TupleLeaf<I, Ts>... {
+public:
+    TupleImpl() = default;
+
+    template<typename... Args> explicit TupleImpl(const Args&... args) noexcept : TupleLeaf<I, Ts>(args)... {}
+};
+
+// Inline storage for a fixed pack of possibly different types, every element is constructed in place.
+template<typename... Ts> class Tuple : public TupleImpl<MakeIndexSequence<sizeof...(Ts)>, Ts...> {
+public:
+    Tuple() = default;
+    Tuple(const Tuple&) = default;
+    Tuple& operator=(const Tuple&) = default;
+
+    template<typename... Args> explicit Tuple(const Args&... args) noexcept : TupleImpl<MakeIndexSequence<sizeof...(Ts)>, Ts...>(args...) {
+        static_assert(sizeof...(Args) == sizeof...(Ts), "Tuple needs one constructor argument per element");
+    }
+
+    static constexpr size_t Size() noexcept {
+        return sizeof...(Ts);
+    }
+};
+
+template<size_t I, typename T> constexpr T& tupleLeaf(TupleLeaf<I, T>& leaf) noexcept {
+    return leaf.value;
+}
+
+template<size_t I, typename T> constexpr const T& tupleLeaf(const TupleLeaf<I, T>& leaf) noexcept {
+    return leaf.value;
+}
+
+template<size_t I, typename... Ts> constexpr auto& get(Tuple<Ts...>& tuple) noexcept {
+    return tupleLeaf<I>(tuple);
+}
+
+template<size_t I, typename... Ts> constexpr const auto& get(const Tuple<Ts...>& tuple) noexcept {
+    return tupleLeaf<I>(tuple);
+}
+
+template<typename Alloc> class BasicString {
+private:
+    static constexpr size_t INLINE_CAPACITY = 22;
+
+    size_t len = 0;
+    size_t cap = INLINE_CAPACITY;
+    union {
+        char* heap;
+        char local[INLINE_CAPACITY + 1];
+    };
+    // Set when the allocator failed and characters were dropped, see Truncated().
+    bool truncated = false;
+    [[no_unique_address]] Alloc alloc;
+
+    static size_t c_strlen(const char* str) noexcept {
+        if (!str) return 0;
+        const char* ptr = str;
+        while (*ptr) ptr++;
+        return (size_t)(ptr - str);
+    }
+
+    static void copyChars(char* dst, const char* src, size_t count) noexcept {
+        for (size_t i = 0; i < count; ++i) dst[i] = src[i];
+    }
+
+    bool isInline() const noexcept {
+        return cap == INLINE_CAPACITY;
+    }
+
+    char* buffer() noexcept {
+        return isInline() ? local : heap;
+    }
+
+    const char* buffer() const noexcept {
+        return isInline() ? local : heap;
+    }
+
+    void freeHeap() noexcept {
+        if (!isInline()) alloc.deallocate(heap, cap + 1, 1);
+    }
+
+    void release() noexcept {
+        freeHeap();
+        cap = INLINE_CAPACITY;
+        local[0] = '\0';
+        len = 0;
+        truncated = false;
+    }
+
+    void grow(size_t required) noexcept {
+        size_t newCap = cap * 2;
+        if (newCap < required) newCap = required;
+        reserve(newCap);
+    }
+
+    void assign(const char* str, size_t count) noexcept {
+        len = 0;
+        truncated = false;
+        if (count > cap) (void)reserve(count);
+        if (count > cap) {
+            count = cap;
+            truncated = true;
+        }
+        char* d = buffer();
+        copyChars(d, str, count);
+        d[count] = '\0';
+        len = count;
+    }
+
+    void steal(BasicString& other) noexcept {
+        len = other.len;
+        cap = other.cap;
+        truncated = other.truncated;
+        if (other.isInline()) copyChars(local, other.local, len + 1);
+        else heap = other.heap;
+        other.cap = INLINE_CAPACITY;
+        other.local[0] = '\0';
+        other.len = 0;
+        other.truncated = false;
+    }
+
+    static size_t partLength(const char* str) noexcept {
+        return c_strlen(str);
+    }
+
+    static size_t partLength(const BasicString& str) noexcept {
+        return str.len;
+    }
+
+    // Allocator of the first BasicString among concat parts, default constructed when there is none.
+    static Alloc partAllocator() noexcept {
+        return Alloc();
+    }
+
+    template<typename... Rest> static Alloc partAllocator(const char*, const Rest&... rest) noexcept {
+        return partAllocator(rest...);
+    }
+
+    template<typename... Rest> static Alloc partAllocator(const BasicString& str, const Rest&...) noexcept {
+        return str.alloc;
+    }
+
+public:
+    BasicString() noexcept {
+        local[0] = '\0';
+    }
+
+    explicit BasicString(const Alloc& p_alloc) noexcept : alloc(p_alloc) {
+        local[0] = '\0';
+    }
+
+    BasicString(const char* cstr, const Alloc& p_alloc = Alloc()) noexcept : BasicString(cstr, c_strlen(cstr), p_alloc) {}
+
+    BasicString(const char* cstr, size_t length, const Alloc& p_alloc = Alloc()) noexcept : alloc(p_alloc) {
+        local[0] = '\0';
+        assign(cstr, length);
+    }
+
+    BasicString(size_t count, char ch, const Alloc& p_alloc = Alloc()) noexcept : alloc(p_alloc) {
+        local[0] = '\0';
+        (void)reserve(count);
+        if (count > cap) {
+            count = cap;
+            truncated = true;
+        }
+        char* d = buffer();
+        for (size_t i = 0; i < count; ++i) d[i] = ch;
+        d[count] = '\0';
+        len = count;
+    }
+
+    BasicString(const BasicString& other) noexcept : BasicString(other.c_str(), other.len, other.alloc) {
+        truncated = truncated || other.truncated;
+    }
+
+    BasicString(BasicString&& other) noexcept : alloc(other.alloc) {
+        steal(other);
+    }
+
+    ~BasicString() noexcept {
+        freeHeap();
+    }
+
+    BasicString& operator=(const BasicString& other) noexcept {
+        if (this != &other) {
+            assign(other.c_str(), other.len);
+            truncated = truncated || other.truncated;
+        }
+        return *this;
+    }
+
+    BasicString& operator=(BasicString&& other) noexcept {
+        if (this != &other) {
+            release();
+            alloc = other.alloc;
+            steal(other);
+        }
+        return *this;
+    }
+
+    BasicString& operator=(const char* cstr) noexcept {
+        assign(cstr, c_strlen(cstr));
+        return *this;
+    }
+
+    Error reserve(size_t newCapacity) noexcept {
+        if (newCapacity <= cap) return ErrorCode::success;
+
+        char* newData = static_cast<char*>(alloc.allocate(newCapacity + 1, 1));
+        if (newData == nullptr) {
+            return Error(ErrorCode::allocationFailed, "could not reserve string storage");
+        }
+        copyChars(newData, buffer(), len + 1);
+
+        freeHeap();
+        heap = newData;
+        cap = newCapacity;
+        return ErrorCode::success;
+    }
+
+    const char* c_str() const noexcept {
+        return buffer();
+    }
+
+    char* Data() noexcept {
+        return buffer();
+    }
+
+    const char* Data() const noexcept {
+        return buffer();
+    }
+
+    size_t length() const noexcept {
+        return len;
+    }
+
+    size_t Size() const noexcept {
+        return len;
+    }
+
+    size_t capacity() const noexcept {
+        return cap;
+    }
+
+    bool empty() const noexcept {
+        return len == 0;
+    }
+
+    void clear() noexcept {
+        len = 0;
+        truncated = false;
+        buffer()[0] = '\0';
+    }
+
+    // True when an allocation failed and the content was cut to the capacity that could be kept.
+    // Cleared by clear() and by assigning content that fits.
+    bool Truncated() const noexcept {
+        return truncated;
+    }
+
+    char& operator[](size_t index) noexcept {
+        return buffer()[index];
+    }
+
+    const char& operator[](size_t index) const noexcept {
+        return buffer()[index];
+    }
+
+    BasicString& append(const char* str, size_t count) noexcept {
+        if (len + count > cap) {
+            // str may point into this string (s += s), growing frees or overwrites the old buffer
+            const char* old = buffer();
+            const bool aliased = str >= old && str <= old + len;
+            const size_t offset = aliased ? (size_t)(str - old) : 0;
+            grow(len + count);
+            if (aliased) str = buffer() + offset;
+        }
+        if (len + count > cap) {
+            count = cap - len;
+            truncated = true;
+        }
+        char* d = buffer();
+        copyChars(d + len, str, count);
+        len += count;
+        d[len] = '\0';
+        return *this;
+    }
+
+    BasicString& operator+=(const BasicString& other) noexcept {
+        truncated = truncated || other.truncated;
+        return append(other.c_str(), other.len);
+    }
+
+    BasicString& operator+=(const char* other) noexcept {
+        return append(other, c_strlen(other));
+    }
+
+    BasicString& operator+=(char ch) noexcept {
+        return append(&ch, 1);
+    }
+
+    BasicString operator+(const BasicString& other) const & noexcept {
+        BasicString result(alloc);
+        result.truncated = truncated || other.truncated;
+        (void)result.reserve(len + other.len);
+        result.append(c_str(), len);
+        result.append(other.c_str(), other.len);
+        return result;
+    }
+
+    BasicString operator+(const char* other) const & noexcept {
+        size_t otherLen = c_strlen(other);
+        BasicString result(alloc);
+        result.truncated = truncated;
+        (void)result.reserve(len + otherLen);
+        result.append(c_str(), len);
+        result.append(other, otherLen);
+        return result;
+    }
+
+    BasicString operator+(const BasicString& other) && noexcept {
+        *this += other;
+        return util::move(*this);
+    }
+
+    BasicString operator+(const char* other) && noexcept {
+        *this += other;
+        return util::move(*this);
+    }
+
+    bool operator==(const BasicString& other) const noexcept {
+        if (len != other.len) return false;
+        const char* d = c_str();
+        const char* o = other.c_str();
+        for (size_t i = 0; i < len; ++i) if (d[i] != o[i]) return false;
+        return true;
+    }
+
+    bool operator==(const char* other) const noexcept {
+        if (!other) return len == 0;
+        const char* d = c_str();
+        for (size_t i = 0; i < len; ++i) if (other[i] == '\0' || d[i] != other[i]) return false;
+        return other[len] == '\0';
+    }
+
+    bool operator!=(const BasicString& other) const noexcept {
+        return !(*this == other);
+    }
+    
+    bool operator!=(const char* other) const noexcept {
+        return !(*this == other);
+    }
+
+    template<typename... Parts> BasicString& appendAll(const Parts&... parts) noexcept {
+        (void)reserve(len + (partLength(parts) + ... + 0));
+        (*this += ... += parts);
+        return *this;
+    }
+
+    // Allocates with the allocator of the first BasicString part, for C string only parts build
+    // the result with BasicString(alloc).appendAll(parts...) instead.
+    template<typename... Parts> static BasicString concat(const Parts&... parts) noexcept {
+        BasicString result(partAllocator(parts...));
+        result.appendAll(parts...);
+        return result;
+    }
+
+    const Alloc& Allocator() const noexcept {
+        return alloc;
+    }
+};
+
+template<typename Alloc> BasicString<Alloc> operator+(const char* str1, const BasicString<Alloc>& str2) noexcept {
+    BasicString<Alloc> result(str2.Allocator());
+    result.appendAll(str1, str2);
+    return result;
+}
+
+template<typename Alloc> bool operator==(const char* lhs, const BasicString<Alloc>& rhs) noexcept {
+    return rhs == lhs;
+}
+template<typename Alloc> bool operator!=(const char* lhs, const BasicString<Alloc>& rhs) noexcept {
+    return !(rhs == lhs);
+}
+
+template<typename K, typename V> struct FlatMapSlot {
+    K key = K();
+    V value = V();
+    ui_t distance = 0;
+};
+
+// Integer and enum keys, Fibonacci multiplied so consecutive ids spread over the table.
+template<typename K> struct FlatHash {
+    ull_t operator()(const K& key) const noexcept {
+        ull_t h = static_cast<ull_t>(key) * 0x9E3779B97F4A7C15ULL;
+        return h ^ (h >> 32);
+    }
+};
+
+template<typename Alloc> struct FlatHash<BasicString<Alloc>> {
+    ull_t operator()(const BasicString<Alloc>& key) const noexcept {
+        ull_t h = 0xCBF29CE484222325ULL;
+        const char *data = key.Data();
+        for(size_t i = 0; i < key.Size(); i++) {
+            h = (h ^ static_cast<uc_t>(data[i])) * 0x100000001B3ULL;
+        }
+        return h;
+    }
+};
+
+// Smallest power of two slot count that keeps capacity entries under the 7/8 load limit.
+constexpr size_t flatMapSlots(size_t capacity) noexcept {
+    size_t slots = 8;
+    while(slots / 8 * 7 < capacity) slots *= 2;
+    return slots;
+}
+
+// Open addressing hash map with robin hood probing in one flat slot array. Slot distance is the
+// probe length plus one, 0 marks an empty slot; lookups stop as soon as they meet a slot closer to
+// its home than the probe, so misses are as short as hits. Keys and values must be default
+// constructible. Storage is Array<FlatMapSlot<K, V>> (grows by doubling) or DefinedArray for a
+// fixed inline table, see the FlatMap and StaticFlatMap aliases.
+template<typename K, typename V, typename Storage, typename Hash = FlatHash<K>> class BasicFlatMap {
+public:
+    using Slot = FlatMapSlot<K, V>;
+
+protected:
+    static constexpr size_t MIN_SLOTS = 8;
+
+    Storage slots;
+    size_t size = 0;
+    [[no_unique_address]] Hash hash;
+
+    template<typename Alloc> static Error allocateSlots(Array<Slot, Alloc>& storage, size_t count) noexcept {
+        storage = Array<Slot, Alloc>(count, storage.Allocator());
+        if(storage.Size() != count) {
+            return Error(ErrorCode::allocationFailed, "could not allocate flat map slots");
+        }
+        return ErrorCode::success;
+    }
+
+    template<size_t N> static Error allocateSlots(DefinedArray<Slot, N>& storage, size_t count) noexcept {
+        (void)storage;
+        (void)count;
+        return ErrorCode::success;
+    }
+
+    // Empty slot storage drawing from the same allocator instance as storage.
+    template<typename Alloc> static Array<Slot, Alloc> emptySlots(const Array<Slot, Alloc>& storage) noexcept {
+        return Array<Slot, Alloc>(storage.Allocator());
+    }
+
+    template<size_t N> static DefinedArray<Slot, N> emptySlots(const DefinedArray<Slot, N>&) noexcept {
+        return DefinedArray<Slot, N>();
+    }
+
+    template<typename Alloc> static constexpr size_t maxSlots(const Array<Slot, Alloc>&) noexcept {
+        return ~size_t(0);
+    }
+
+    template<size_t N> static constexpr size_t maxSlots(const DefinedArray<Slot, N>&) noexcept {
+        return N;
+    }
+
+    size_t home(const K& key) const noexcept {
+        return static_cast<size_t>(hash(key)) & (slots.Size() - 1);
+    }
+
+    static bool fits(size_t count, size_t slotCount) noexcept {
+        return count * 8 <= slotCount * 7;
+    }
+
+    void place(Slot&& entry) noexcept {
+        const size_t mask = slots.Size() - 1;
+        size_t i = home(entry.key);
+        entry.distance = 1;
+        while(true) {
+            Slot& slot = slots[i];
+            if(slot.distance == 0) {
+                slot = util::move(entry);
+                return;
+            }
+            if(slot.distance < entry.distance) util::swap(slot, entry);
+            entry.distance++;
+            i = (i + 1) & mask;
+        }
+    }
+
+    size_t locate(const K& key) const noexcept {
+        if(size == 0) return slots.Size();
+        const size_t mask = slots.Size() - 1;
+        size_t i = home(key);
+        for(ui_t distance = 1;; distance++) {
+            const Slot& slot = slots[i];
+            if(slot.distance < distance) return slots.Size();
+            if(slot.distance == distance && slot.key == key) return i;
+            i = (i + 1) & mask;
+        }
+    }
+
+    Error rehash(size_t count) noexcept {
+        if(count > maxSlots(slots)) {
+            return Error(ErrorCode::capacityExceeded, "static flat map is full");
+        }
+
+        Storage fresh = emptySlots(slots);
+        Error err = allocateSlots(fresh, count);
+        if(err) return err;
+
+        util::swap(slots, fresh);
+        for(size_t i = 0; i < fresh.Size(); i++) {
+            if(fresh[i].distance != 0) place(util::move(fresh[i]));
+        }
+        return ErrorCode::success;
+    }
+
+public:
+    BasicFlatMap() = default;
+
+    // Slots are allocated from alloc, e.g. a ResourceAllocator bound to an arena.
+    template<typename Alloc, typename = EnableIf<IsSame<Storage, Array<Slot, Alloc>>::value>> explicit BasicFlatMap(const Alloc& alloc) noexcept
+    : slots(alloc) {}
+
+    // Makes room for count entries up front, so inserting them later cannot fail or rehash.
+    [[nodiscard]] Error reserve(size_t count) noexcept {
+        if(fits(count, slots.Size())) return ErrorCode::success;
+        size_t wanted = slots.Size() < MIN_SLOTS ? MIN_SLOTS : slots.Size();
+        while(!fits(count, wanted)) wanted *= 2;
+        return rehash(wanted);
+    }
+
+    // Inserts key or overwrites the value already stored under it.
+    [[nodiscard]] Error insert(const K& key, const V& value) noexcept {
+        const size_t index = locate(key);
+        if(index != slots.Size()) {
+            slots[index].value = value;
+            return ErrorCode::success;
+        }
+
+        if(!fits(size + 1, slots.Size())) {
+            Error err = rehash(slots.Size() < MIN_SLOTS ? MIN_SLOTS : slots.Size() * 2);
+            if(err) return err;
+        }
+
+        Slot entry;
+        entry.key = key;
+        entry.value = value;
+        place(util::move(entry));
+        size++;
+        return ErrorCode::success;
+    }
+
+    // Removes key with backward shift deletion, so no tombstones are left behind.
+    [[nodiscard]] Error erase(const K& key) noexcept {
+        size_t index = locate(key);
+        if(index == slots.Size()) {
+            return Error(ErrorCode::keyNotFound, "flat map has no such key to erase");
+        }
+
+        const size_t mask = slots.Size() - 1;
+        size_t next = (index + 1) & mask;
+        while(slots[next].distance > 1) {
+            slots[index] = util::move(slots[next]);
+            slots[index].distance--;
+            index = next;
+            next = (next + 1) & mask;
+        }
+        slots[index] = Slot();
+        size--;
+        return ErrorCode::success;
+    }
+
+    V* find(const K& key) noexcept {
+        const size_t index = locate(key);
+        return index == slots.Size() ? nullptr : &slots[index].value;
+    }
+
+    const V* find(const K& key) const noexcept {
+        const size_t index = locate(key);
+        return index == slots.Size() ? nullptr : &slots[index].value;
+    }
+
+    [[nodiscard]] Result<V&> at(const K& key) noexcept {
+        V *value = find(key);
+        if(value == nullptr) {
+            return Error(ErrorCode::keyNotFound, "flat map has no such key");
+        }
+        return *value;
+    }
+
+    [[nodiscard]] Result<const V&> at(const K& key) const noexcept {
+        const V *value = find(key);
+        if(value == nullptr) {
+            return Error(ErrorCode::keyNotFound, "flat map has no such key");
+        }
+        return *value;
+    }
+
+    bool contains(const K& key) const noexcept {
+        return locate(key) != slots.Size();
+    }
+
+    // Calls f(key, value) for every entry in slot order.
+    template<typename F> void forEach(F&& f) const {
+        for(size_t i = 0; i < slots.Size(); i++) {
+            if(slots[i].distance != 0) f(slots[i].key, slots[i].value);
+        }
+    }
+
+    void clear() noexcept {
+        for(size_t i = 0; i < slots.Size(); i++) slots[i] = Slot();
+        size = 0;
+    }
+
+    size_t Size() const noexcept {
+        return size;
+    }
+
+    bool empty() const noexcept {
+        return size == 0;
+    }
+
+    // Entries that fit before the next rehash.
+    size_t Capacity() const noexcept {
+        return slots.Size() / 8 * 7;
+    }
+};
+
+template<typename K, typename V, typename Hash = FlatHash<K>, typename Alloc = HeapAllocator>
+using FlatMap = BasicFlatMap<K, V, Array<FlatMapSlot<K, V>, Alloc>, Hash>;
+
+template<typename K, typename V, size_t CAPACITY, typename Hash = FlatHash<K>>
+using StaticFlatMap = BasicFlatMap<K, V, DefinedArray<FlatMapSlot<K, V>, flatMapSlots(CAPACITY)>, Hash>;
+
+} //namespace vislib::util
+
+// to_string moved to format.hpp next to to_chars. errors.hpp includes it once Result is complete, so
+// code including only this header still gets to_string.
+#include "errors.hpp"
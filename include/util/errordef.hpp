@@ -11,10 +11,68 @@ enum class ErrorCode {
     outOfRange,
     indexOutOfRange,
     emptyArray,
-    zeroDivision
+    zeroDivision,
+    allocationFailed,
+    capacityExceeded,
+    singularMatrix,
+    keyNotFound
 };
 
-class Error;
+class HeapAllocator;
+template<typename Alloc = HeapAllocator> class BasicString;
+using String = BasicString<>;
 template<typename T> class Result;
 
+class Error {
+public:
+    ErrorCode errcode = ErrorCode::success;
+    const char* msg = "Successful operation";
+    const char* context = nullptr;
+
+    static constexpr const char* defaultMessage(ErrorCode code) noexcept {
+        switch (code) {
+            case ErrorCode::success: return "Successful operation";
+            case ErrorCode::initFailed: return "Initialization failed";
+            case ErrorCode::invalidArgument: return "Invalid argument";
+            case ErrorCode::failedConnection: return "Connection failed";
+            case ErrorCode::outOfRange: return "Value out of range";
+            case ErrorCode::indexOutOfRange: return "Index out of range";
+            case ErrorCode::emptyArray: return "Empty array";
+            case ErrorCode::zeroDivision: return "Division by zero";
+            case ErrorCode::allocationFailed: return "Memory allocation failed";
+            case ErrorCode::capacityExceeded: return "Container capacity exceeded";
+            case ErrorCode::singularMatrix: return "Matrix is singular";
+            case ErrorCode::keyNotFound: return "Key not found";
+            default: return "Undefined error occur";
+        }
+    }
+
+    constexpr operator ErrorCode() const noexcept { return errcode; }
+
+    constexpr operator long long() const noexcept { return static_cast<long long>(errcode); }
+
+    operator String() const noexcept;
+
+    constexpr operator const char*() const noexcept { return msg; }
+
+    constexpr explicit operator bool() const noexcept { return errcode != ErrorCode::success; }
+
+    constexpr bool operator==(const Error& err) const noexcept {
+        return errcode == err.errcode;
+    }
+
+    constexpr Error() noexcept = default;
+
+    constexpr Error(ErrorCode code, const char* p_msg = nullptr) noexcept
+    : errcode(code), msg(code == ErrorCode::success || p_msg == nullptr ? defaultMessage(code) : p_msg) {}
+
+    constexpr Error withContext(const char* p_context) const noexcept {
+        Error err = *this;
+        err.context = p_context;
+        return err;
+    }
+};
+
+static_assert(__is_trivially_copyable(Error), "Error must stay trivially copyable to keep the error path allocation free");
+
 } //namespace vislib::util
@@ -1,33 +1,40 @@
 #pragma once
 
 #include "containers.hpp"
+#include "memory.hpp"
 
 namespace vislib::util {
 
-class Error {
+inline Error::operator String() const noexcept {
+    if (context == nullptr) return String(msg);
+    return String::concat(context, ", error encountered: ", msg);
+}
+
+class DetailedError {
 public:
-    ErrorCode errcode;
-    String msg = "Success";
+    Error err;
+    String details;
 
-    operator ErrorCode() const noexcept { return errcode; }
+    DetailedError() noexcept = default;
 
-    operator long long() const noexcept { return static_cast<long long>(errcode); }
+    DetailedError(Error p_err) noexcept : err(p_err) {}
 
-    operator String() const noexcept { return msg; }
+    DetailedError(ErrorCode code) noexcept : err(code) {}
 
-    operator const char*() const noexcept { return msg.c_str(); }
+    DetailedError(Error p_err, String p_details) noexcept : err(p_err), details(util::move(p_details)) {}
 
-    explicit operator bool() const noexcept { return errcode != ErrorCode::success; }
+    operator Error() const noexcept { return err; }
 
-    virtual bool operator==(const Error& err) const noexcept {
-        return errcode == err.errcode;
-    }
+    operator ErrorCode() const noexcept { return err.errcode; }
 
-    Error() noexcept : errcode(ErrorCode::success), msg("Successful operation") {}
+    explicit operator bool() const noexcept { return static_cast<bool>(err); }
+
+    bool operator==(const Error& other) const noexcept {
+        return err == other;
+    }
 
-    Error(ErrorCode code, String p_msg = "Default error") noexcept : errcode(code), msg(p_msg) {
-        if (code == ErrorCode::success) msg = "Successful operation";
-        else if(p_msg == "Default error") msg = "Undefined error occur";
+    const char* c_str() const noexcept {
+        return details.length() == 0 ? err.msg : details.c_str();
     }
 };
 
@@ -35,14 +42,65 @@ template <typename T, typename E> class ReturnResult {
 protected:
 
     bool errorFlag = false;
-    T value;
-    E err;
+    union {
+        T value;
+        E err;
+    };
+
+    void destroy() noexcept {
+        if (errorFlag) err.~E();
+        else value.~T();
+    }
+
+    void constructFrom(const ReturnResult& other) noexcept {
+        errorFlag = other.errorFlag;
+        if (errorFlag) new (&err) E(other.err);
+        else new (&value) T(other.value);
+    }
+
+    void constructFrom(ReturnResult&& other) noexcept {
+        errorFlag = other.errorFlag;
+        if (errorFlag) new (&err) E(util::move(other.err));
+        else new (&value) T(util::move(other.value));
+    }
 
 public:
 
-    ReturnResult(T v) noexcept : errorFlag(false), value(v) { }
+    ReturnResult(const T& v) noexcept : errorFlag(false), value(v) { }
+
+    ReturnResult(T&& v) noexcept : errorFlag(false), value(util::move(v)) { }
 
-    ReturnResult(E e) noexcept : errorFlag(true), err(e) { }
+    ReturnResult(const E& e) noexcept : errorFlag(true), err(e) { }
+
+    ReturnResult(E&& e) noexcept : errorFlag(true), err(util::move(e)) { }
+
+    ReturnResult(const ReturnResult& other) noexcept {
+        constructFrom(other);
+    }
+
+    ReturnResult(ReturnResult&& other) noexcept {
+        constructFrom(util::move(other));
+    }
+
+    ~ReturnResult() noexcept {
+        destroy();
+    }
+
+    ReturnResult& operator=(const ReturnResult& other) noexcept {
+        if (this != &other) {
+            destroy();
+            constructFrom(other);
+        }
+        return *this;
+    }
+
+    ReturnResult& operator=(ReturnResult&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            constructFrom(util::move(other));
+        }
+        return *this;
+    }
 
     bool isError() const noexcept { return errorFlag; }
     bool isOK() const noexcept { return !errorFlag; }
@@ -63,21 +121,29 @@ public:
         return false;
     }
 
-    operator T() const noexcept { return value; }
-    operator E() const noexcept { return err; }
+    operator const T&() const & noexcept { return value; }
+    operator T() && noexcept { return util::move(value); }
+    operator const E&() const noexcept { return err; }
 
     operator bool() const noexcept { return errorFlag; }
 
-    T operator()() const noexcept { return value; }
+    T& operator()() & noexcept { return value; }
+    const T& operator()() const & noexcept { return value; }
+    T operator()() && noexcept { return util::move(value); }
+
+    T& Value() & noexcept { return value; }
+    const T& Value() const & noexcept { return value; }
+    T Value() && noexcept { return util::move(value); }
 
-    T Value() const noexcept { return value; }
+    T take() noexcept { return util::move(value); }
 
-    E Err() const noexcept { return err; }
+    const E& Err() const noexcept { return err; }
 };
 
 template <typename T> class Result : public ReturnResult<T, Error> {
 public:
-    Result(T v) noexcept : ReturnResult<T, Error>(v) {}
+    Result(const T& v) noexcept : ReturnResult<T, Error>(v) {}
+    Result(T&& v) noexcept : ReturnResult<T, Error>(util::move(v)) {}
     Result(Error e) noexcept : ReturnResult<T, Error>(e) {}
 };
 
@@ -93,3 +159,6 @@ public:
 
 
 } //namespace vislib::util
+
+// Last, to_chars needs Result complete whichever of containers.hpp, errors.hpp and format.hpp is included first.
+#include "format.hpp"
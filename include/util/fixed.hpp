@@ -0,0 +1,287 @@
+#pragma once
+
+#include "math.hpp"
+#include "memory.hpp"
+#include "types.hpp"
+
+namespace vislib::util {
+
+template <size_t BITS> struct FixedStorage;
+
+template <> struct FixedStorage<8> {
+    using Raw = signed char;
+    using Wide = s_t;
+};
+
+template <> struct FixedStorage<16> {
+    using Raw = s_t;
+    using Wide = i_t;
+};
+
+template <> struct FixedStorage<32> {
+    using Raw = i_t;
+    using Wide = ll_t;
+};
+
+// Signed fixed-point number with IntBits integer bits, FracBits fractional bits and a sign bit.
+// Every operation saturates to the representable range instead of wrapping, division by zero
+// saturates towards the sign of the dividend.
+template <size_t IntBits, size_t FracBits> class Fixed {
+    static_assert(IntBits + FracBits <= 31, "Fixed supports at most 31 magnitude bits");
+
+public:
+    using Storage = FixedStorage<(IntBits + FracBits < 8) ? 8 : (IntBits + FracBits < 16) ? 16 : 32>;
+    using RawType = typename Storage::Raw;
+    using WideType = typename Storage::Wide;
+
+    static constexpr size_t INT_BITS = IntBits;
+    static constexpr size_t FRAC_BITS = FracBits;
+    static constexpr WideType ONE = WideType(1) << FracBits;
+    static constexpr WideType MAX_RAW = (WideType(1) << (IntBits + FracBits)) - 1;
+    static constexpr WideType MIN_RAW = -(WideType(1) << (IntBits + FracBits));
+
+protected:
+    RawType raw = 0;
+
+    static constexpr RawType saturate(WideType value) noexcept {
+        if (value > MAX_RAW) return static_cast<RawType>(MAX_RAW);
+        if (value < MIN_RAW) return static_cast<RawType>(MIN_RAW);
+        return static_cast<RawType>(value);
+    }
+
+    template <typename A> static constexpr RawType fromArithmetic(A value) noexcept {
+        if constexpr (static_cast<A>(0.5) != 0) {
+            double scaled = static_cast<double>(value) * static_cast<double>(ONE);
+            scaled += scaled < 0 ? -0.5 : 0.5;
+            if (scaled >= static_cast<double>(MAX_RAW)) return static_cast<RawType>(MAX_RAW);
+            if (scaled <= static_cast<double>(MIN_RAW)) return static_cast<RawType>(MIN_RAW);
+            return static_cast<RawType>(static_cast<WideType>(scaled));
+        } else {
+            if (value > static_cast<A>(0) && static_cast<ull_t>(value) > static_cast<ull_t>(MAX_RAW >> FracBits)) return static_cast<RawType>(MAX_RAW);
+            if (value < static_cast<A>(0) && static_cast<ll_t>(value) < static_cast<ll_t>(MIN_RAW >> FracBits)) return static_cast<RawType>(MIN_RAW);
+            return static_cast<RawType>(static_cast<WideType>(value) * ONE);
+        }
+    }
+
+public:
+    constexpr Fixed() = default;
+    constexpr Fixed(const Fixed&) = default;
+    constexpr Fixed& operator=(const Fixed&) = default;
+
+    template <typename A, typename = EnableIf<IsArithmetic<A>::value>> constexpr Fixed(A value) noexcept : raw(fromArithmetic(value)) {}
+
+    template <size_t I, size_t F> explicit constexpr Fixed(Fixed<I, F> other) noexcept {
+        ll_t value = other.Raw();
+        if constexpr (F > FracBits) {
+            value = (value + (ll_t(1) << (F - FracBits - 1))) >> (F - FracBits);
+        } else {
+            value *= ll_t(1) << (FracBits - F);
+        }
+        raw = value > MAX_RAW ? static_cast<RawType>(MAX_RAW) : value < MIN_RAW ? static_cast<RawType>(MIN_RAW) : static_cast<RawType>(value);
+    }
+
+    static constexpr Fixed fromRaw(RawType value) noexcept {
+        Fixed result;
+        result.raw = saturate(value);
+        return result;
+    }
+
+    static constexpr Fixed max() noexcept {
+        return fromRaw(static_cast<RawType>(MAX_RAW));
+    }
+
+    static constexpr Fixed min() noexcept {
+        return fromRaw(static_cast<RawType>(MIN_RAW));
+    }
+
+    static constexpr Fixed epsilon() noexcept {
+        return fromRaw(1);
+    }
+
+    constexpr RawType Raw() const noexcept {
+        return raw;
+    }
+
+    // Integer conversions truncate towards zero, like a floating point cast does.
+    template <typename A, typename = EnableIf<IsArithmetic<A>::value>> explicit constexpr operator A() const noexcept {
+        if constexpr (static_cast<A>(0.5) != 0) {
+            return static_cast<A>(static_cast<double>(raw) / static_cast<double>(ONE));
+        } else {
+            return static_cast<A>(static_cast<WideType>(raw) / ONE);
+        }
+    }
+
+    constexpr Fixed operator-() const noexcept {
+        Fixed result;
+        result.raw = saturate(-static_cast<WideType>(raw));
+        return result;
+    }
+
+    constexpr Fixed operator+() const noexcept {
+        return *this;
+    }
+
+    constexpr Fixed& operator+=(Fixed other) noexcept {
+        raw = saturate(static_cast<WideType>(raw) + other.raw);
+        return *this;
+    }
+
+    constexpr Fixed& operator-=(Fixed other) noexcept {
+        raw = saturate(static_cast<WideType>(raw) - other.raw);
+        return *this;
+    }
+
+    constexpr Fixed& operator*=(Fixed other) noexcept {
+        WideType product = static_cast<WideType>(raw) * other.raw;
+        if constexpr (FracBits > 0) {
+            product = (product + (WideType(1) << (FracBits - 1))) >> FracBits;
+        }
+        raw = saturate(product);
+        return *this;
+    }
+
+    constexpr Fixed& operator/=(Fixed other) noexcept {
+        if (other.raw == 0) {
+            raw = raw < 0 ? static_cast<RawType>(MIN_RAW) : static_cast<RawType>(MAX_RAW);
+            return *this;
+        }
+        raw = saturate(static_cast<WideType>(raw) * ONE / other.raw);
+        return *this;
+    }
+
+    friend constexpr Fixed operator+(Fixed x, Fixed y) noexcept {
+        return x += y;
+    }
+
+    friend constexpr Fixed operator-(Fixed x, Fixed y) noexcept {
+        return x -= y;
+    }
+
+    friend constexpr Fixed operator*(Fixed x, Fixed y) noexcept {
+        return x *= y;
+    }
+
+    friend constexpr Fixed operator/(Fixed x, Fixed y) noexcept {
+        return x /= y;
+    }
+
+    friend constexpr bool operator==(Fixed x, Fixed y) noexcept {
+        return x.raw == y.raw;
+    }
+
+    friend constexpr bool operator!=(Fixed x, Fixed y) noexcept {
+        return x.raw != y.raw;
+    }
+
+    friend constexpr bool operator<(Fixed x, Fixed y) noexcept {
+        return x.raw < y.raw;
+    }
+
+    friend constexpr bool operator<=(Fixed x, Fixed y) noexcept {
+        return x.raw <= y.raw;
+    }
+
+    friend constexpr bool operator>(Fixed x, Fixed y) noexcept {
+        return x.raw > y.raw;
+    }
+
+    friend constexpr bool operator>=(Fixed x, Fixed y) noexcept {
+        return x.raw >= y.raw;
+    }
+
+    // x * y / z with a wide intermediate, so Range::map does not saturate on the product.
+    friend constexpr Fixed mulDiv(Fixed x, Fixed y, Fixed z) noexcept {
+        WideType product = static_cast<WideType>(x.raw) * y.raw;
+        if (z.raw == 0) {
+            return fromRaw(static_cast<RawType>(product < 0 ? MIN_RAW : MAX_RAW));
+        }
+        Fixed result;
+        result.raw = saturate(product / z.raw);
+        return result;
+    }
+
+    friend constexpr Fixed sqrtF(Fixed x) noexcept {
+        if (x.raw <= 0) return Fixed();
+
+        ull_t value = static_cast<ull_t>(x.raw) << FracBits;
+        ull_t root = 0;
+        ull_t bit = ull_t(1) << 62;
+        while (bit > value) bit >>= 2;
+
+        while (bit != 0) {
+            if (value >= root + bit) {
+                value -= root + bit;
+                root = (root >> 1) + bit;
+            } else {
+                root >>= 1;
+            }
+            bit >>= 2;
+        }
+
+        Fixed result;
+        result.raw = saturate(static_cast<WideType>(root));
+        return result;
+    }
+};
+
+template <size_t IntBits, size_t FracBits> struct ScalarTraits<Fixed<IntBits, FracBits>> {
+    using Accumulator = Fixed<IntBits, FracBits>;
+};
+
+// Q15 holds normalized values in [-1, 1), Q16 holds values up to +-32768 with 16 fractional bits.
+using Q15 = Fixed<0, 15>;
+using Q16 = Fixed<15, 16>;
+
+template <typename S> struct FixedQuarterWave {
+    typename S::RawType values[TRIG_QUARTER_STEPS + 1];
+};
+
+template <typename S> constexpr FixedQuarterWave<S> makeFixedQuarterWave() noexcept {
+    FixedQuarterWave<S> wave = {};
+    for(size_t i = 0; i <= TRIG_QUARTER_STEPS; i++) {
+        wave.values[i] = S(seriesSin(static_cast<double>(i) * (M_PI / 2.0) / static_cast<double>(TRIG_QUARTER_STEPS))).Raw();
+    }
+    return wave;
+}
+
+// TrigTable in fixed point: the angle in degrees, the table and the interpolation are all integer
+// math, so a Fixed kinematics pipeline needs no floating point at runtime. S has to hold +-720
+// degrees, Q16 does.
+template <typename S> struct TrigFixedTable {
+    static_assert(S::INT_BITS >= 10, "TrigFixedTable needs at least 10 integer bits for the angle in degrees");
+
+    using Scalar = S;
+    using RawType = typename S::RawType;
+
+    static constexpr size_t QUARTER_STEPS = TRIG_QUARTER_STEPS;
+    static constexpr size_t FULL_STEPS = QUARTER_STEPS * 4;
+
+    static constexpr FixedQuarterWave<S> wave = makeFixedQuarterWave<S>();
+
+    static ll_t sample(size_t index) noexcept {
+        index &= FULL_STEPS - 1;
+        size_t offset = index & (QUARTER_STEPS - 1);
+        switch (index / QUARTER_STEPS) {
+            case 0: return wave.values[offset];
+            case 1: return wave.values[QUARTER_STEPS - offset];
+            case 2: return -static_cast<ll_t>(wave.values[offset]);
+            default: return -static_cast<ll_t>(wave.values[QUARTER_STEPS - offset]);
+        }
+    }
+
+    static void sincosDegrees(S angle, S& s, S& c) noexcept {
+        // Table position in 2^-FRAC_BITS steps, shifted by whole turns so it is never negative.
+        const ll_t turns = static_cast<ll_t>(FULL_STEPS) << (S::INT_BITS + S::FRAC_BITS);
+        const ull_t position = static_cast<ull_t>(static_cast<ll_t>(angle.Raw()) * static_cast<ll_t>(FULL_STEPS) / 360 + turns);
+        const size_t index = static_cast<size_t>(position >> S::FRAC_BITS) & (FULL_STEPS - 1);
+        const ll_t frac = static_cast<ll_t>(position & ((ull_t(1) << S::FRAC_BITS) - 1));
+        const ll_t half = ll_t(1) << (S::FRAC_BITS - 1);
+
+        const ll_t s0 = sample(index);
+        const ll_t c0 = sample(index + QUARTER_STEPS);
+        s = S::fromRaw(static_cast<RawType>(s0 + (((sample(index + 1) - s0) * frac + half) >> S::FRAC_BITS)));
+        c = S::fromRaw(static_cast<RawType>(c0 + (((sample(index + QUARTER_STEPS + 1) - c0) * frac + half) >> S::FRAC_BITS)));
+    }
+};
+
+} //namespace vislib::util
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <math.h>
+#include "types.hpp"
+#include "errordef.hpp"
+#include "errors.hpp"
+#include "memory.hpp"
+#include "containers.hpp"
+
+namespace vislib::util {
+
+constexpr char DIGIT_PAIRS[201] =
+    "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+    "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+inline size_t decimalDigits(ull_t value) noexcept {
+    size_t digits = 1;
+    while(true) {
+        if(value < 10) return digits;
+        if(value < 100) return digits + 1;
+        if(value < 1000) return digits + 2;
+        if(value < 10000) return digits + 3;
+        value /= 10000;
+        digits += 4;
+    }
+}
+
+// Writes the digits of value so that the last one lands just before end, two digits per division.
+inline void writeDigits(char *end, ull_t value) noexcept {
+    while(value >= 100) {
+        const size_t pair = static_cast<size_t>(value % 100) * 2;
+        value /= 100;
+        *--end = DIGIT_PAIRS[pair + 1];
+        *--end = DIGIT_PAIRS[pair];
+    }
+    if(value >= 10) {
+        const size_t pair = static_cast<size_t>(value) * 2;
+        *--end = DIGIT_PAIRS[pair + 1];
+        *--end = DIGIT_PAIRS[pair];
+    } else {
+        *--end = static_cast<char>('0' + value);
+    }
+}
+
+inline Error bufferTooSmall() noexcept {
+    return Error(ErrorCode::capacityExceeded, "buffer is too small for the formatted number");
+}
+
+// Formats value into [first, last) without a terminating zero and returns the end of the written
+// characters, like std::to_chars. Nothing is allocated and nothing is written when it does not fit.
+template<typename T, typename = EnableIf<IsIntegral<T>::value && !IsSame<RemoveConst<T>, bool>::value>>
+[[nodiscard]] Result<char*> to_chars(char *first, char *last, T value) noexcept {
+    const bool negative = value < static_cast<T>(0);
+    const ull_t magnitude = negative ? 0ULL - static_cast<ull_t>(value) : static_cast<ull_t>(value);
+    const size_t length = decimalDigits(magnitude) + (negative ? 1 : 0);
+
+    if(first == nullptr || static_cast<size_t>(last - first) < length) return bufferTooSmall();
+
+    if(negative) *first = '-';
+    writeDigits(first + length, magnitude);
+    return first + length;
+}
+
+constexpr size_t MAX_FIXED_PRECISION = 18;
+
+// 10^exponent from correctly rounded binary powers, at most nine roundings.
+inline double powerOfTen(size_t exponent) noexcept {
+    constexpr double POWERS[] = {1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256};
+    double result = 1;
+    for(size_t bit = 0; exponent != 0 && bit < 9; bit++, exponent >>= 1) {
+        if(exponent & 1) result *= POWERS[bit];
+    }
+    return result;
+}
+
+// Fixed notation with precision digits after the point. Below 1.8e19 the integer part is exact and
+// the fraction is rounded from the exact binary value with ties to even, matching printf for
+// precision up to 15. Larger values are printed from their 17 leading digits and zero filled, so the
+// last of those may differ from the exact expansion. The sign follows the sign bit, so negative zero
+// and negative values rounding to zero keep their "-" as with printf. nan and inf are written as
+// "nan", "inf" and "-inf", nan never carries a sign.
+[[nodiscard]] inline Result<char*> to_chars(char *first, char *last, double value, size_t precision = 6) noexcept {
+    if(precision > MAX_FIXED_PRECISION) {
+        return Error(ErrorCode::invalidArgument, "fixed precision is limited to 18 digits");
+    }
+    if(first == nullptr) return bufferTooSmall();
+
+    const size_t available = static_cast<size_t>(last - first);
+    const bool negative = signbit(value) != 0;
+    const double magnitude = negative ? -value : value;
+
+    if(magnitude != magnitude || magnitude > 1.7976931348623157e308) {
+        const char *text = magnitude != magnitude ? "nan" : negative ? "-inf" : "inf";
+        size_t length = 0;
+        while(text[length] != 0) length++;
+        if(available < length) return bufferTooSmall();
+        for(size_t i = 0; i < length; i++) first[i] = text[i];
+        return first + length;
+    }
+
+    ull_t fractionScale = 1;
+    for(size_t i = 0; i < precision; i++) fractionScale *= 10;
+
+    ull_t integerPart = 0;
+    ull_t fraction = 0;
+    size_t zeroFill = 0;
+
+    if(magnitude < 1.8e19) {
+        integerPart = static_cast<ull_t>(magnitude);
+        const double fractional = magnitude - static_cast<double>(integerPart);
+        const double scaled = fractional * static_cast<double>(fractionScale);
+        // fma recovers the rounding error of the product, so ties and near ties are decided exactly.
+        const double error = fma(fractional, static_cast<double>(fractionScale), -scaled);
+        fraction = static_cast<ull_t>(scaled);
+        const double aboveHalf = (scaled - static_cast<double>(fraction) - 0.5) + error;
+        const ull_t lastDigit = precision > 0 ? fraction : integerPart;
+        if(aboveHalf > 0 || (aboveHalf == 0 && (lastDigit & 1) != 0)) fraction++;
+        if(fraction == fractionScale) {
+            fraction = 0;
+            integerPart++;
+        }
+    } else {
+        zeroFill = 3;
+        while(magnitude >= powerOfTen(zeroFill + 17)) zeroFill++;
+        integerPart = static_cast<ull_t>(magnitude / powerOfTen(zeroFill) + 0.5);
+    }
+
+    const size_t integerDigits = decimalDigits(integerPart);
+    const size_t length = (negative ? 1 : 0) + integerDigits + zeroFill + (precision > 0 ? precision + 1 : 0);
+    if(available < length) return bufferTooSmall();
+
+    char *out = first;
+    if(negative) *out++ = '-';
+    writeDigits(out + integerDigits, integerPart);
+    out += integerDigits;
+    for(size_t i = 0; i < zeroFill; i++) *out++ = '0';
+
+    if(precision > 0) {
+        *out++ = '.';
+        const size_t fractionDigits = decimalDigits(fraction);
+        for(size_t i = fractionDigits; i < precision; i++) *out++ = '0';
+        writeDigits(out + fractionDigits, fraction);
+        out += fractionDigits;
+    }
+
+    return out;
+}
+
+[[nodiscard]] inline Result<char*> to_chars(char *first, char *last, float value, size_t precision = 6) noexcept {
+    return to_chars(first, last, static_cast<double>(value), precision);
+}
+
+template<typename T, typename = EnableIf<IsIntegral<T>::value && !IsSame<RemoveConst<T>, bool>::value>>
+String to_string(T value) noexcept {
+    char buf[24];
+    Result<char*> end = to_chars(buf, buf + sizeof(buf), value);
+    return String(buf, static_cast<size_t>(end() - buf));
+}
+
+// Precision above MAX_FIXED_PRECISION is clamped to it. The buffer fits every finite double, so the
+// result is only empty if String itself cannot allocate.
+inline String to_string(double value, size_t precision = 6) noexcept {
+    char buf[340];
+    Result<char*> end = to_chars(buf, buf + sizeof(buf), value, precision < MAX_FIXED_PRECISION ? precision : MAX_FIXED_PRECISION);
+    if(end) return String();
+    return String(buf, static_cast<size_t>(end() - buf));
+}
+
+} //namespace vislib::util
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "types.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+// Define VISLIB_INSTRUMENTATION to 1 before including vislib to count heap allocations made through
+// HeapAllocator and to record cycle counts of the probed hot paths. With the default 0 the hooks are
+// empty inline functions and VISLIB_PROBE expands to nothing.
+#ifndef VISLIB_INSTRUMENTATION
+#define VISLIB_INSTRUMENTATION 0
+#endif
+
+namespace vislib::util::instrumentation {
+
+// Free running cycle counter. Targets without one of the counters below can supply their own with
+// #define VISLIB_CYCLE_COUNTER() expression. On Cortex-M the DWT counter has to be enabled by the
+// application (CoreDebug->DEMCR TRCENA and DWT->CTRL CYCCNTENA).
+inline ull_t cycleCount() noexcept {
+#if defined(VISLIB_CYCLE_COUNTER)
+    return static_cast<ull_t>(VISLIB_CYCLE_COUNTER());
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_ia32_rdtsc();
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif defined(__aarch64__)
+    ull_t value;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+    return *reinterpret_cast<volatile ui_t*>(0xE0001004);
+#else
+    return 0;
+#endif
+}
+
+// Log2 histogram of cycle counts, bucket i holds samples in [2^i, 2^(i+1)), bucket 0 also holds 0
+// and the last bucket everything above. Fixed size so recording never allocates.
+template<size_t BUCKETS = 32> class CycleHistogram {
+    static_assert(BUCKETS > 0 && BUCKETS <= 64, "CycleHistogram supports 1 to 64 buckets");
+
+protected:
+    ull_t buckets[BUCKETS] = {};
+    ull_t count = 0;
+    ull_t total = 0;
+    ull_t minimum = ~0ULL;
+    ull_t maximum = 0;
+
+public:
+    static size_t bucketOf(ull_t cycles) noexcept {
+        size_t bucket = 0;
+#if defined(__GNUC__) || defined(__clang__)
+        bucket = static_cast<size_t>(63 - __builtin_clzll(cycles | 1));
+#else
+        while (cycles > 1) {
+            cycles >>= 1;
+            bucket++;
+        }
+#endif
+        return bucket < BUCKETS ? bucket : BUCKETS - 1;
+    }
+
+    void record(ull_t cycles) noexcept {
+        buckets[bucketOf(cycles)]++;
+        count++;
+        total += cycles;
+        if (cycles < minimum) minimum = cycles;
+        if (cycles > maximum) maximum = cycles;
+    }
+
+    void reset() noexcept {
+        for (size_t i = 0; i < BUCKETS; i++) buckets[i] = 0;
+        count = 0;
+        total = 0;
+        minimum = ~0ULL;
+        maximum = 0;
+    }
+
+    ull_t Bucket(size_t index) const noexcept {
+        return index < BUCKETS ? buckets[index] : 0;
+    }
+
+    static constexpr size_t Buckets() noexcept {
+        return BUCKETS;
+    }
+
+    ull_t Count() const noexcept {
+        return count;
+    }
+
+    ull_t Total() const noexcept {
+        return total;
+    }
+
+    ull_t Min() const noexcept {
+        return count == 0 ? 0 : minimum;
+    }
+
+    ull_t Max() const noexcept {
+        return maximum;
+    }
+
+    // Smallest bucket bound below which at least fraction of the samples fall.
+    ull_t percentileBound(double fraction) const noexcept {
+        const double wanted = fraction * static_cast<double>(count);
+        ull_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; i++) {
+            seen += buckets[i];
+            if (seen > 0 && static_cast<double>(seen) >= wanted) return i + 1 < 64 ? (1ULL << (i + 1)) : ~0ULL;
+        }
+        return maximum;
+    }
+};
+
+enum class Probe : size_t {
+    platformSetSpeeds,
+    platformSetSpeedsInRanges,
+    platformInit,
+    linearSpeeds,
+    kinematicsCompute,
+    kinematicsBatch,
+    count
+};
+
+using ProbeHistogram = CycleHistogram<>;
+
+// Heap traffic through HeapAllocator. The counters are plain integers, read them from the thread that
+// drives the control loop or while the other threads are idle.
+struct AllocationStats {
+    ull_t allocations = 0;
+    ull_t deallocations = 0;
+    ull_t failures = 0;
+    size_t totalBytes = 0;
+    size_t liveBytes = 0;
+    size_t peakBytes = 0;
+};
+
+#if VISLIB_INSTRUMENTATION
+
+inline AllocationStats allocationStats;
+inline ProbeHistogram probeHistograms[static_cast<size_t>(Probe::count)];
+
+inline void noteAllocation(const void *ptr, size_t bytes) noexcept {
+    if (ptr == nullptr) {
+        allocationStats.failures++;
+        return;
+    }
+    allocationStats.allocations++;
+    allocationStats.totalBytes += bytes;
+    allocationStats.liveBytes += bytes;
+    if (allocationStats.liveBytes > allocationStats.peakBytes) allocationStats.peakBytes = allocationStats.liveBytes;
+}
+
+inline void noteDeallocation(const void *ptr, size_t bytes) noexcept {
+    if (ptr == nullptr) return;
+    allocationStats.deallocations++;
+    allocationStats.liveBytes -= bytes < allocationStats.liveBytes ? bytes : allocationStats.liveBytes;
+}
+
+inline void resetAllocationStats() noexcept {
+    allocationStats = AllocationStats();
+}
+
+inline ProbeHistogram& probeHistogram(Probe probe) noexcept {
+    return probeHistograms[static_cast<size_t>(probe)];
+}
+
+inline void resetProbes() noexcept {
+    for (ProbeHistogram& histogram : probeHistograms) histogram.reset();
+}
+
+class ScopedProbe {
+protected:
+    ProbeHistogram& histogram;
+    ull_t start;
+
+public:
+    explicit ScopedProbe(Probe probe) noexcept : histogram(probeHistogram(probe)), start(cycleCount()) {}
+
+    ScopedProbe(const ScopedProbe&) = delete;
+    ScopedProbe& operator=(const ScopedProbe&) = delete;
+
+    ~ScopedProbe() noexcept {
+        histogram.record(cycleCount() - start);
+    }
+};
+
+#define VISLIB_PROBE_CONCAT_IMPL(a, b) a##b
+#define VISLIB_PROBE_CONCAT(a, b) VISLIB_PROBE_CONCAT_IMPL(a, b)
+#define VISLIB_PROBE(probe) ::vislib::util::instrumentation::ScopedProbe VISLIB_PROBE_CONCAT(vislibProbe, __LINE__)(::vislib::util::instrumentation::Probe::probe)
+
+#else
+
+inline void noteAllocation(const void*, size_t) noexcept {}
+inline void noteDeallocation(const void*, size_t) noexcept {}
+
+#define VISLIB_PROBE(probe) ((void)0)
+
+#endif
+
+} //namespace vislib::util::instrumentation
@@ -2,8 +2,35 @@
 
 #include <math.h>
 #include "containers.hpp"
+#include "errors.hpp"
 #include "memory.hpp"
 
+#if !defined(VISLIB_NO_SIMD)
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define VISLIB_SIMD_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define VISLIB_SIMD_NEON 1
+#endif
+#endif
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define VISLIB_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+
+#ifndef VISLIB_CONSTANT_EVALUATED
+#define VISLIB_CONSTANT_EVALUATED() true
+#endif
+
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#define VISLIB_RESTRICT __restrict
+#else
+#define VISLIB_RESTRICT
+#endif
+
 namespace vislib::util {
 
 template <typename T> T absF(const T& x) noexcept {
@@ -65,22 +92,153 @@ template <typename T> T maxEq(const T& x, const T& y) noexcept {
     return y;
 }
 
-double cosDegrees(double angle) noexcept {
+inline double cosDegrees(double angle) noexcept {
     return cos(angle * M_PI / 180.0);
 }
 
-double sinDegrees(double angle) noexcept {
+inline double sinDegrees(double angle) noexcept {
     return sin(angle * M_PI / 180.0);
 }
 
-double deg2Rad(double angle) noexcept {
+inline double deg2Rad(double angle) noexcept {
     return angle * M_PI / 180.0;
 }
 
-double rad2Deg(double angle) noexcept {
+inline double rad2Deg(double angle) noexcept {
     return angle * 180.0 / M_PI;
 }
 
+inline void sincosDegrees(double angle, double& s, double& c) noexcept {
+    double radians = angle * M_PI / 180.0;
+    s = sin(radians);
+    c = cos(radians);
+}
+
+struct TrigExact {
+    using Scalar = double;
+
+    static void sincosDegrees(double angle, double& s, double& c) noexcept {
+        util::sincosDegrees(angle, s, c);
+    }
+};
+
+struct TrigPolynomial {
+    using Scalar = float;
+
+    static void sincosDegrees(float angle, float& s, float& c) noexcept {
+        float turns = angle * (1.0f / 90.0f);
+        long quadrant = static_cast<long>(turns >= 0 ? turns + 0.5f : turns - 0.5f);
+        float x = (angle - static_cast<float>(quadrant) * 90.0f) * static_cast<float>(M_PI / 180.0);
+        float x2 = x * x;
+
+        float sinX = x + x * x2 * (-1.6666654611e-1f + x2 * (8.3321608736e-3f + x2 * -1.9515295891e-4f));
+        float cosX = 1.0f - 0.5f * x2 + x2 * x2 * (4.166664568298827e-2f + x2 * (-1.388731625493765e-3f + x2 * 2.443315711809948e-5f));
+
+        switch (quadrant & 3) {
+            case 0: s = sinX; c = cosX; break;
+            case 1: s = cosX; c = -sinX; break;
+            case 2: s = -sinX; c = -cosX; break;
+            default: s = -cosX; c = sinX; break;
+        }
+    }
+};
+
+constexpr size_t TRIG_QUARTER_STEPS = 128;
+
+struct TrigQuarterWave {
+    float values[TRIG_QUARTER_STEPS + 1];
+};
+
+constexpr double seriesSin(double x) noexcept {
+    double term = x;
+    double sum = x;
+    for(size_t k = 1; k < 12; k++) {
+        term *= -x * x / static_cast<double>((2 * k) * (2 * k + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr TrigQuarterWave makeTrigQuarterWave() noexcept {
+    TrigQuarterWave wave = {};
+    for(size_t i = 0; i <= TRIG_QUARTER_STEPS; i++) {
+        wave.values[i] = static_cast<float>(seriesSin(static_cast<double>(i) * (M_PI / 2.0) / static_cast<double>(TRIG_QUARTER_STEPS)));
+    }
+    return wave;
+}
+
+struct TrigTable {
+    using Scalar = float;
+
+    static constexpr size_t QUARTER_STEPS = TRIG_QUARTER_STEPS;
+    static constexpr size_t FULL_STEPS = QUARTER_STEPS * 4;
+
+    static constexpr TrigQuarterWave wave = makeTrigQuarterWave();
+
+    static float sample(size_t index) noexcept {
+        index &= FULL_STEPS - 1;
+        size_t offset = index & (QUARTER_STEPS - 1);
+        switch (index / QUARTER_STEPS) {
+            case 0: return wave.values[offset];
+            case 1: return wave.values[QUARTER_STEPS - offset];
+            case 2: return -wave.values[offset];
+            default: return -wave.values[QUARTER_STEPS - offset];
+        }
+    }
+
+    static void sincosDegrees(float angle, float& s, float& c) noexcept {
+        float position = angle * (static_cast<float>(FULL_STEPS) / 360.0f);
+        float base = floorf(position);
+        float frac = position - base;
+        size_t index = static_cast<size_t>(static_cast<long>(base)) & (FULL_STEPS - 1);
+
+        float s0 = sample(index);
+        float s1 = sample(index + 1);
+        float c0 = sample(index + QUARTER_STEPS);
+        float c1 = sample(index + QUARTER_STEPS + 1);
+
+        s = s0 + (s1 - s0) * frac;
+        c = c0 + (c1 - c0) * frac;
+    }
+};
+
+template <typename Policy> void sincosDegrees(typename Policy::Scalar angle, typename Policy::Scalar& s, typename Policy::Scalar& c) noexcept {
+    Policy::sincosDegrees(angle, s, c);
+}
+
+template <typename Policy> typename Policy::Scalar sinDegrees(typename Policy::Scalar angle) noexcept {
+    typename Policy::Scalar s = 0, c = 0;
+    Policy::sincosDegrees(angle, s, c);
+    return s;
+}
+
+template <typename Policy> typename Policy::Scalar cosDegrees(typename Policy::Scalar angle) noexcept {
+    typename Policy::Scalar s = 0, c = 0;
+    Policy::sincosDegrees(angle, s, c);
+    return c;
+}
+
+// The exact policy evaluates only the function that was asked for.
+template <> inline double sinDegrees<TrigExact>(double angle) noexcept {
+    return sinDegrees(angle);
+}
+
+template <> inline double cosDegrees<TrigExact>(double angle) noexcept {
+    return cosDegrees(angle);
+}
+
+template <typename T> T mulDiv(const T& x, const T& y, const T& z) noexcept {
+    return x * y / z;
+}
+
+template <typename T> auto sqrtF(const T& x) noexcept {
+    return sqrt(x);
+}
+
+template <typename T> struct ScalarTraits {
+    using Accumulator = double;
+};
+
 template <typename T> class Range {
 public:
     T lowest = 0;
@@ -90,7 +248,7 @@ public:
         if (in_max == in_min) {
             return out_min;
         }
-        return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+        return mulDiv(D(x - in_min), D(out_max - out_min), D(in_max - in_min)) + out_min;
     }
 
     template<typename D> static D map(D x, const Range<D>& in, const Range<D>& out) noexcept {
@@ -100,6 +258,7 @@ public:
     Range() = default;
     Range(const Range&) = default;
     Range(T p_lowest, T p_highest) noexcept : lowest(p_lowest), highest(p_highest) {}
+    template<typename O> Range(const Range<O>& other) noexcept : lowest(static_cast<T>(other.lowest)), highest(static_cast<T>(other.highest)) {}
 
     bool contains(T v) const noexcept {
         return v >= lowest && v <= highest;
@@ -121,10 +280,236 @@ public:
 
 };
 
-template <typename T> class Vector {
+// Range::map between two fixed ranges reduced to x * scale + offset. A clamp of the input to the
+// source range is folded into a clamp of the output, which is equivalent as the map is monotonic.
+template <typename T> class LinearMap {
+protected:
+    T scale = 1;
+    T offset = 0;
+    T low = 0;
+    T high = 0;
+    bool clamped = false;
+
+public:
+    LinearMap() = default;
+
+    LinearMap(const Range<T>& from, const Range<T>& to, bool clamp = false) noexcept : clamped(clamp) {
+        if (from.highest == from.lowest) {
+            scale = 0;
+            offset = to.lowest;
+        } else {
+            scale = (to.highest - to.lowest) / (from.highest - from.lowest);
+            offset = to.lowest - from.lowest * scale;
+        }
+        low = minF(to.lowest, to.highest);
+        high = maxF(to.lowest, to.highest);
+    }
+
+    T operator()(T x) const noexcept {
+        T y = x * scale + offset;
+        if (clamped) {
+            if (y < low) return low;
+            if (y > high) return high;
+        }
+        return y;
+    }
+
+    // Map applied to -x, used for reversed motors.
+    LinearMap negatedInput() const noexcept {
+        LinearMap result = *this;
+        result.scale = -scale;
+        return result;
+    }
+
+    // Map returning -y, used for reversed motors.
+    LinearMap negatedOutput() const noexcept {
+        LinearMap result = *this;
+        result.scale = -scale;
+        result.offset = -offset;
+        result.low = -high;
+        result.high = -low;
+        return result;
+    }
+
+    T Scale() const noexcept {
+        return scale;
+    }
+
+    T Offset() const noexcept {
+        return offset;
+    }
+
+    bool Clamped() const noexcept {
+        return clamped;
+    }
+};
+
+template <typename T> class Vector;
+
+template <typename E> class VectorExpr {
+public:
+    const E& self() const noexcept {
+        return static_cast<const E&>(*this);
+    }
+
+    size_t Size() const noexcept {
+        return self().Size();
+    }
+
+    auto operator[](size_t index) const noexcept {
+        return self()[index];
+    }
+
+    auto module() const noexcept {
+        typename ScalarTraits<typename E::ValueType>::Accumulator buffer = 0;
+        const E& e = self();
+        size_t n = e.Size();
+        
+        for(size_t i = 0; i < n; i++) {
+            buffer += e[i] * e[i];
+        }
+        
+        return sqrtF(buffer);
+    }
+
+    template <typename O> auto dot(const VectorExpr<O>& other) const noexcept {
+        typename ScalarTraits<typename E::ValueType>::Accumulator buffer = 0;
+        const E& e = self();
+        const O& o = other.self();
+        size_t n = minF(e.Size(), o.Size());
+        
+        for(size_t i = 0; i < n; i++) {
+            buffer += e[i] * o[i];
+        }
+        
+        return buffer;
+    }
+};
+
+template <typename E> struct VectorOperand {
+    using type = const E;
+};
+
+template <typename T> struct VectorOperand<Vector<T>> {
+    using type = const Vector<T>&;
+};
+
+template <typename L, typename R> class VectorSum : public VectorExpr<VectorSum<L, R>> {
+protected:
+    typename VectorOperand<L>::type lhs;
+    typename VectorOperand<R>::type rhs;
+    size_t common;
+
+public:
+    using ValueType = typename L::ValueType;
+
+    VectorSum(const L& l, const R& r) noexcept : lhs(l), rhs(r), common(minF(l.Size(), r.Size())) {}
+
+    size_t Size() const noexcept {
+        return lhs.Size();
+    }
+
+    ValueType operator[](size_t i) const noexcept {
+        return i < common ? ValueType(lhs[i] + rhs[i]) : ValueType(lhs[i]);
+    }
+};
+
+template <typename L, typename R> class VectorDifference : public VectorExpr<VectorDifference<L, R>> {
+protected:
+    typename VectorOperand<L>::type lhs;
+    typename VectorOperand<R>::type rhs;
+    size_t common;
+
+public:
+    using ValueType = typename L::ValueType;
+
+    VectorDifference(const L& l, const R& r) noexcept : lhs(l), rhs(r), common(minF(l.Size(), r.Size())) {}
+
+    size_t Size() const noexcept {
+        return lhs.Size();
+    }
+
+    ValueType operator[](size_t i) const noexcept {
+        return i < common ? ValueType(lhs[i] - rhs[i]) : ValueType(lhs[i]);
+    }
+};
+
+template <typename E> class VectorScaled : public VectorExpr<VectorScaled<E>> {
+public:
+    using ValueType = typename E::ValueType;
+
+protected:
+    typename VectorOperand<E>::type expr;
+    ValueType factor;
+
+public:
+    VectorScaled(const E& e, const ValueType& k) noexcept : expr(e), factor(k) {}
+
+    size_t Size() const noexcept {
+        return expr.Size();
+    }
+
+    ValueType operator[](size_t i) const noexcept {
+        return expr[i] * factor;
+    }
+};
+
+template <typename E> class VectorDivided : public VectorExpr<VectorDivided<E>> {
+public:
+    using ValueType = typename E::ValueType;
+
+protected:
+    typename VectorOperand<E>::type expr;
+    ValueType divisor;
+    bool divide;
+
+public:
+    VectorDivided(const E& e, const ValueType& k) noexcept : expr(e), divisor(k), divide(!(k == 0)) {}
+
+    size_t Size() const noexcept {
+        return expr.Size();
+    }
+
+    ValueType operator[](size_t i) const noexcept {
+        return divide ? ValueType(expr[i] / divisor) : ValueType(expr[i]);
+    }
+};
+
+template <typename E> class VectorNegated : public VectorExpr<VectorNegated<E>> {
+public:
+    using ValueType = typename E::ValueType;
+
+protected:
+    typename VectorOperand<E>::type expr;
+
+public:
+    explicit VectorNegated(const E& e) noexcept : expr(e) {}
+
+    size_t Size() const noexcept {
+        return expr.Size();
+    }
+
+    ValueType operator[](size_t i) const noexcept {
+        return -expr[i];
+    }
+};
+
+template <typename T> class Vector : public VectorExpr<Vector<T>> {
 protected:
     Array<T> data;
+
+    template <typename E> void evaluate(const VectorExpr<E>& expr) noexcept {
+        const E& e = expr.self();
+        size_t n = e.Size();
+        T* out = data.Data();
+        for(size_t i = 0; i < n; i++) {
+            out[i] = e[i];
+        }
+    }
+
 public:
+    using ValueType = T;
+
     Vector() = default;
     Vector(const Vector&) = default;
     Vector(Vector&&) = default;
@@ -133,6 +518,21 @@ public:
     
     explicit Vector(const Array<T>& arr) noexcept : data(arr) { }
     explicit Vector(Array<T>&& arr) noexcept : data(util::move(arr)) { }
+
+    template <typename E> Vector(const VectorExpr<E>& expr) noexcept : data(expr.Size()) {
+        evaluate(expr);
+    }
+
+    template <typename E> Vector& operator=(const VectorExpr<E>& expr) noexcept {
+        if (data.Size() == expr.Size()) {
+            evaluate(expr);
+            return *this;
+        }
+
+        Vector<T> temp(expr);
+        data = util::move(temp.data);
+        return *this;
+    }
     
     operator Array<T>&() noexcept {
         return data;
@@ -149,115 +549,500 @@ public:
     const Array<T>& raw() const noexcept {
         return data;
     }
-    
-    Vector operator+(const Vector& other) const noexcept {
-        Vector<T> temp = *this;
-        for(size_t i = 0; i < minF(temp.Size(), other.Size()); i++) {
-            temp.at(i) += other.at(i);
-        }
-        return temp;
+
+    size_t Size() const noexcept {
+        return data.Size();
     }
-    
-    Vector& operator+=(const Vector& other) noexcept {
-        for(size_t i = 0; i < minF(this->Size(), other.Size()); i++) {
-            this->at(i) += other.at(i);
-        }
-        return *this;
+
+    T& operator[](size_t index) noexcept {
+        return data[index];
     }
-    
-    Vector operator-(const Vector& other) const noexcept {
-        Vector<T> temp = *this;
-        for(size_t i = 0; i < minF(temp.Size(), other.Size()); i++) {
-            temp.at(i) -= other.at(i);
-        }
-        return temp;
+
+    const T& operator[](size_t index) const noexcept {
+        return data[index];
+    }
+
+    [[nodiscard]] Result<T&> at(size_t index) noexcept {
+        return data.at(index);
+    }
+
+    [[nodiscard]] Result<const T&> at(size_t index) const noexcept {
+        return data.at(index);
     }
     
-    Vector& operator-=(const Vector& other) noexcept {
-        for(size_t i = 0; i < minF(this->Size(), other.Size()); i++) {
-            this->at(i) -= other.at(i);
+    template <typename E> Vector& operator+=(const VectorExpr<E>& other) noexcept {
+        const E& o = other.self();
+        size_t n = minF(Size(), o.Size());
+        for(size_t i = 0; i < n; i++) {
+            data[i] += o[i];
         }
         return *this;
     }
     
-    Vector operator*(const T& value) const noexcept {
-        Vector<T> temp = *this;
-        for(size_t i = 0; i < temp.Size(); i++) {
-            temp.at(i) *= value;
+    template <typename E> Vector& operator-=(const VectorExpr<E>& other) noexcept {
+        const E& o = other.self();
+        size_t n = minF(Size(), o.Size());
+        for(size_t i = 0; i < n; i++) {
+            data[i] -= o[i];
         }
-        return temp;
+        return *this;
     }
     
     Vector& operator*=(const T& value) noexcept {
-        for(size_t i = 0; i < this->Size(); i++) {
-            this->at(i) *= value;
+        size_t n = Size();
+        for(size_t i = 0; i < n; i++) {
+            data[i] *= value;
         }
         return *this;
     }
     
-    Vector operator/(const T& value) const noexcept {
-        if(value == 0) return *this;
-        
-        Vector<T> temp = *this;
-        for(size_t i = 0; i < temp.Size(); i++) {
-            temp.at(i) /= value;
-        }
-        
-        return temp;
-    }
-    
     Vector& operator/=(const T& value) noexcept {
         if(value == 0) return *this;
         
-        for(size_t i = 0; i < this->Size(); i++) {
-            this->at(i) /= value;
+        size_t n = Size();
+        for(size_t i = 0; i < n; i++) {
+            data[i] /= value;
         }
         
         return *this;
     }
     
-    Vector operator-() const noexcept {
-        Vector<T> temp = *this;
-        for(size_t i = 0; i < temp.Size(); i++) {
-            temp.at(i) = -temp.at(i);
-        }
-        return temp;
+    Vector normal() const noexcept {
+        return *this / static_cast<T>(this->module());
     }
     
-    double module() const noexcept {
-        double buffer = 0;
-        
-        for(size_t i = 0; i < this->Size(); i++) {
-            buffer += this->at(i) * this->at(i);
-        }
-        
-        return sqrt(buffer);
-        
+    void normalize() noexcept {
+        auto m = this->module();
+        if (m != 0) *this /= m;
     }
     
-    double dot(const Vector& other) const noexcept {
-        double buffer = 0;
-        
-        for(size_t i = 0; i < minF(other.Size(), this->Size()); i++) {
-            buffer += this->at(i) * other.at(i);
+};
+
+template <typename L, typename R> VectorSum<L, R> operator+(const VectorExpr<L>& lhs, const VectorExpr<R>& rhs) noexcept {
+    return VectorSum<L, R>(lhs.self(), rhs.self());
+}
+
+template <typename L, typename R> VectorDifference<L, R> operator-(const VectorExpr<L>& lhs, const VectorExpr<R>& rhs) noexcept {
+    return VectorDifference<L, R>(lhs.self(), rhs.self());
+}
+
+template <typename E> VectorScaled<E> operator*(const VectorExpr<E>& expr, const typename E::ValueType& value) noexcept {
+    return VectorScaled<E>(expr.self(), value);
+}
+
+template <typename E> VectorScaled<E> operator*(const typename E::ValueType& value, const VectorExpr<E>& expr) noexcept {
+    return VectorScaled<E>(expr.self(), value);
+}
+
+template <typename E> VectorDivided<E> operator/(const VectorExpr<E>& expr, const typename E::ValueType& value) noexcept {
+    return VectorDivided<E>(expr.self(), value);
+}
+
+template <typename E> VectorNegated<E> operator-(const VectorExpr<E>& expr) noexcept {
+    return VectorNegated<E>(expr.self());
+}
+
+template <typename T, size_t N> struct VecSimd {
+    static constexpr bool enabled = false;
+};
+
+#if defined(VISLIB_SIMD_SSE)
+
+template <> struct VecSimd<float, 4> {
+    static constexpr bool enabled = true;
+
+    static void add(float *out, const float *a, const float *b) noexcept {
+        _mm_store_ps(out, _mm_add_ps(_mm_load_ps(a), _mm_load_ps(b)));
+    }
+
+    static void sub(float *out, const float *a, const float *b) noexcept {
+        _mm_store_ps(out, _mm_sub_ps(_mm_load_ps(a), _mm_load_ps(b)));
+    }
+
+    static void scale(float *out, const float *a, float k) noexcept {
+        _mm_store_ps(out, _mm_mul_ps(_mm_load_ps(a), _mm_set1_ps(k)));
+    }
+
+    static float dot(const float *a, const float *b) noexcept {
+        __m128 m = _mm_mul_ps(_mm_load_ps(a), _mm_load_ps(b));
+        __m128 shuf = _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1));
+        __m128 sums = _mm_add_ps(m, shuf);
+        shuf = _mm_movehl_ps(shuf, sums);
+        sums = _mm_add_ss(sums, shuf);
+        return _mm_cvtss_f32(sums);
+    }
+};
+
+#elif defined(VISLIB_SIMD_NEON)
+
+template <> struct VecSimd<float, 4> {
+    static constexpr bool enabled = true;
+
+    static void add(float *out, const float *a, const float *b) noexcept {
+        vst1q_f32(out, vaddq_f32(vld1q_f32(a), vld1q_f32(b)));
+    }
+
+    static void sub(float *out, const float *a, const float *b) noexcept {
+        vst1q_f32(out, vsubq_f32(vld1q_f32(a), vld1q_f32(b)));
+    }
+
+    static void scale(float *out, const float *a, float k) noexcept {
+        vst1q_f32(out, vmulq_n_f32(vld1q_f32(a), k));
+    }
+
+    static float dot(const float *a, const float *b) noexcept {
+        float32x4_t m = vmulq_f32(vld1q_f32(a), vld1q_f32(b));
+#if defined(__aarch64__)
+        return vaddvq_f32(m);
+#else
+        float32x2_t sums = vadd_f32(vget_low_f32(m), vget_high_f32(m));
+        sums = vpadd_f32(sums, sums);
+        return vget_lane_f32(sums, 0);
+#endif
+    }
+};
+
+#endif
+
+template <typename T, size_t N> class Vec {
+    static_assert(N > 0, "Vec dimension must be positive");
+
+protected:
+    using Indices = MakeIndexSequence<N>;
+
+    template<typename F, size_t... I> static constexpr Vec generate(F f, IndexSequence<I...>) noexcept {
+        return Vec(f(I)...);
+    }
+
+    template<size_t... I> constexpr T dotImpl(const Vec& other, IndexSequence<I...>) const noexcept {
+        return (... + (data[I] * other.data[I]));
+    }
+
+    template<size_t... I> constexpr bool equalImpl(const Vec& other, IndexSequence<I...>) const noexcept {
+        return (... && (data[I] == other.data[I]));
+    }
+
+public:
+    alignas(sizeof(T) * N == 16 ? 16 : alignof(T)) T data[N];
+
+    constexpr Vec() noexcept : data{} {}
+
+    template<typename... Rest> constexpr Vec(T first, Rest... rest) noexcept : data{first, static_cast<T>(rest)...} {
+        static_assert(sizeof...(Rest) + 1 == N, "Vec must be initialized with exactly N components");
+    }
+
+    static constexpr Vec filled(T value) noexcept {
+        return generate([value](size_t) { return value; }, Indices());
+    }
+
+    static constexpr size_t Size() noexcept {
+        return N;
+    }
+
+    constexpr T& operator[](size_t index) noexcept {
+        return data[index];
+    }
+
+    constexpr const T& operator[](size_t index) const noexcept {
+        return data[index];
+    }
+
+    T* Data() noexcept {
+        return data;
+    }
+
+    const T* Data() const noexcept {
+        return data;
+    }
+
+    constexpr Vec operator+(const Vec& other) const noexcept {
+        if (!VISLIB_CONSTANT_EVALUATED()) {
+            if constexpr (VecSimd<T, N>::enabled) {
+                Vec result;
+                VecSimd<T, N>::add(result.data, data, other.data);
+                return result;
+            }
         }
-        
-        return buffer;
+        return generate([this, &other](size_t i) { return data[i] + other.data[i]; }, Indices());
     }
-    
-    Vector normal() const noexcept {
-        return *this / this->module();
+
+    constexpr Vec operator-(const Vec& other) const noexcept {
+        if (!VISLIB_CONSTANT_EVALUATED()) {
+            if constexpr (VecSimd<T, N>::enabled) {
+                Vec result;
+                VecSimd<T, N>::sub(result.data, data, other.data);
+                return result;
+            }
+        }
+        return generate([this, &other](size_t i) { return data[i] - other.data[i]; }, Indices());
     }
-    
+
+    constexpr Vec operator*(const T& value) const noexcept {
+        if (!VISLIB_CONSTANT_EVALUATED()) {
+            if constexpr (VecSimd<T, N>::enabled) {
+                Vec result;
+                VecSimd<T, N>::scale(result.data, data, value);
+                return result;
+            }
+        }
+        return generate([this, &value](size_t i) { return data[i] * value; }, Indices());
+    }
+
+    constexpr Vec operator/(const T& value) const noexcept {
+        if (value == 0) return *this;
+        return generate([this, &value](size_t i) { return data[i] / value; }, Indices());
+    }
+
+    constexpr Vec operator-() const noexcept {
+        return generate([this](size_t i) { return -data[i]; }, Indices());
+    }
+
+    constexpr Vec& operator+=(const Vec& other) noexcept {
+        return *this = *this + other;
+    }
+
+    constexpr Vec& operator-=(const Vec& other) noexcept {
+        return *this = *this - other;
+    }
+
+    constexpr Vec& operator*=(const T& value) noexcept {
+        return *this = *this * value;
+    }
+
+    constexpr Vec& operator/=(const T& value) noexcept {
+        return *this = *this / value;
+    }
+
+    constexpr bool operator==(const Vec& other) const noexcept {
+        return equalImpl(other, Indices());
+    }
+
+    constexpr bool operator!=(const Vec& other) const noexcept {
+        return !(*this == other);
+    }
+
+    constexpr T dot(const Vec& other) const noexcept {
+        if (!VISLIB_CONSTANT_EVALUATED()) {
+            if constexpr (VecSimd<T, N>::enabled) {
+                return VecSimd<T, N>::dot(data, other.data);
+            }
+        }
+        return dotImpl(other, Indices());
+    }
+
+    constexpr T squaredNorm() const noexcept {
+        return dot(*this);
+    }
+
+    T norm() const noexcept {
+        return static_cast<T>(sqrt(squaredNorm()));
+    }
+
+    Vec normal() const noexcept {
+        return *this / norm();
+    }
+
     void normalize() noexcept {
-        auto m = this->module();
-        if (m != 0) *this /= m;
+        T n = norm();
+        if (n != 0) *this /= n;
     }
-    
+
+    constexpr Vec cross(const Vec& other) const noexcept {
+        static_assert(N == 3, "cross product is only defined for 3 dimensional vectors");
+        return Vec(data[1] * other.data[2] - data[2] * other.data[1],
+                   data[2] * other.data[0] - data[0] * other.data[2],
+                   data[0] * other.data[1] - data[1] * other.data[0]);
+    }
+
 };
 
-template<typename T> Vector<T> operator*(const T& val, const Vector<T>& vec) noexcept {
+template<typename T, size_t N> constexpr Vec<T, N> operator*(const T& val, const Vec<T, N>& vec) noexcept {
     return vec * val;
 }
 
+using Vec2f = Vec<float, 2>;
+using Vec3f = Vec<float, 3>;
+using Vec4f = Vec<float, 4>;
+using Vec2d = Vec<double, 2>;
+using Vec3d = Vec<double, 3>;
+using Vec4d = Vec<double, 4>;
+
+template <typename T, size_t R, size_t C> class Matrix {
+    static_assert(R > 0 && C > 0, "Matrix dimensions must be positive");
+
+public:
+    T data[R * C];
+
+    constexpr Matrix() noexcept : data{} {}
+
+    static constexpr Matrix identity() noexcept {
+        static_assert(R == C, "identity matrix must be square");
+        Matrix result;
+        for(size_t i = 0; i < R; i++) result.data[i * C + i] = static_cast<T>(1);
+        return result;
+    }
+
+    static constexpr size_t Rows() noexcept {
+        return R;
+    }
+
+    static constexpr size_t Cols() noexcept {
+        return C;
+    }
+
+    constexpr T& operator()(size_t row, size_t col) noexcept {
+        return data[row * C + col];
+    }
+
+    constexpr const T& operator()(size_t row, size_t col) const noexcept {
+        return data[row * C + col];
+    }
+
+    constexpr Vec<T, C> row(size_t r) const noexcept {
+        Vec<T, C> result;
+        for(size_t c = 0; c < C; c++) result[c] = data[r * C + c];
+        return result;
+    }
+
+    constexpr void setRow(size_t r, const Vec<T, C>& values) noexcept {
+        for(size_t c = 0; c < C; c++) data[r * C + c] = values[c];
+    }
+
+    constexpr Matrix<T, C, R> transpose() const noexcept {
+        Matrix<T, C, R> result;
+        for(size_t r = 0; r < R; r++) {
+            for(size_t c = 0; c < C; c++) result.data[c * R + r] = data[r * C + c];
+        }
+        return result;
+    }
+
+    constexpr Vec<T, R> operator*(const Vec<T, C>& v) const noexcept {
+        Vec<T, R> result;
+        for(size_t r = 0; r < R; r++) {
+            const T *rowData = data + r * C;
+            T sum = 0;
+            for(size_t c = 0; c < C; c++) sum += rowData[c] * v[c];
+            result[r] = sum;
+        }
+        return result;
+    }
+
+    template <size_t K> constexpr Matrix<T, R, K> operator*(const Matrix<T, C, K>& other) const noexcept {
+        Matrix<T, R, K> result;
+        for(size_t r = 0; r < R; r++) {
+            T *out = result.data + r * K;
+            for(size_t c = 0; c < C; c++) {
+                const T factor = data[r * C + c];
+                const T *otherRow = other.data + c * K;
+                for(size_t k = 0; k < K; k++) out[k] += factor * otherRow[k];
+            }
+        }
+        return result;
+    }
+
+    constexpr Matrix operator+(const Matrix& other) const noexcept {
+        Matrix result;
+        for(size_t i = 0; i < R * C; i++) result.data[i] = data[i] + other.data[i];
+        return result;
+    }
+
+    constexpr Matrix operator-(const Matrix& other) const noexcept {
+        Matrix result;
+        for(size_t i = 0; i < R * C; i++) result.data[i] = data[i] - other.data[i];
+        return result;
+    }
+
+    constexpr Matrix operator*(const T& value) const noexcept {
+        Matrix result;
+        for(size_t i = 0; i < R * C; i++) result.data[i] = data[i] * value;
+        return result;
+    }
+
+    constexpr bool operator==(const Matrix& other) const noexcept {
+        for(size_t i = 0; i < R * C; i++) {
+            if (!(data[i] == other.data[i])) return false;
+        }
+        return true;
+    }
+
+    constexpr bool operator!=(const Matrix& other) const noexcept {
+        return !(*this == other);
+    }
+
+};
+
+template <typename T, size_t N, size_t K> Error gaussianEliminate(Matrix<T, N, N> a, Matrix<T, N, K>& b, T tolerance) noexcept {
+    for(size_t col = 0; col < N; col++) {
+        size_t pivot = col;
+        for(size_t r = col + 1; r < N; r++) {
+            if (absF(a(r, col)) > absF(a(pivot, col))) pivot = r;
+        }
+
+        if (absF(a(pivot, col)) <= tolerance) {
+            return Error(ErrorCode::singularMatrix, "could not solve linear system, matrix is singular");
+        }
+
+        if (pivot != col) {
+            for(size_t c = 0; c < N; c++) swap(a(col, c), a(pivot, c));
+            for(size_t c = 0; c < K; c++) swap(b(col, c), b(pivot, c));
+        }
+
+        const T inv = static_cast<T>(1) / a(col, col);
+        for(size_t r = 0; r < N; r++) {
+            if (r == col) continue;
+            const T factor = a(r, col) * inv;
+            if (factor == 0) continue;
+            for(size_t c = col; c < N; c++) a(r, c) -= factor * a(col, c);
+            for(size_t c = 0; c < K; c++) b(r, c) -= factor * b(col, c);
+        }
+    }
+
+    for(size_t r = 0; r < N; r++) {
+        const T inv = static_cast<T>(1) / a(r, r);
+        for(size_t c = 0; c < K; c++) b(r, c) *= inv;
+    }
+
+    return ErrorCode::success;
+}
+
+template <typename T, size_t N> [[nodiscard]] Result<Vec<T, N>> solve(const Matrix<T, N, N>& a, const Vec<T, N>& b, T tolerance = static_cast<T>(1e-9)) noexcept {
+    Matrix<T, N, 1> rhs;
+    for(size_t i = 0; i < N; i++) rhs.data[i] = b[i];
+
+    Error err = gaussianEliminate(a, rhs, tolerance);
+    if (err) return err;
+
+    Vec<T, N> result;
+    for(size_t i = 0; i < N; i++) result[i] = rhs.data[i];
+    return result;
+}
+
+template <typename T, size_t N> [[nodiscard]] Result<Matrix<T, N, N>> inverse(const Matrix<T, N, N>& a, T tolerance = static_cast<T>(1e-9)) noexcept {
+    Matrix<T, N, N> result = Matrix<T, N, N>::identity();
+
+    Error err = gaussianEliminate(a, result, tolerance);
+    if (err) return err;
+
+    return result;
+}
+
+template <typename T, size_t R, size_t C> [[nodiscard]] Result<Matrix<T, C, R>> pseudoInverse(const Matrix<T, R, C>& a, T tolerance = static_cast<T>(1e-9)) noexcept {
+    static_assert(R >= C, "left pseudo inverse requires at least as many rows as columns");
+
+    Matrix<T, C, R> at = a.transpose();
+    Matrix<T, C, R> result = at;
+
+    Error err = gaussianEliminate(at * a, result, tolerance);
+    if (err) return err;
+
+    return result;
+}
+
+template <typename T, size_t R, size_t C> [[nodiscard]] Result<Vec<T, C>> solveLeastSquares(const Matrix<T, R, C>& a, const Vec<T, R>& b, T tolerance = static_cast<T>(1e-9)) noexcept {
+    static_assert(R >= C, "least squares requires at least as many equations as unknowns");
+
+    Matrix<T, C, R> at = a.transpose();
+    return solve(at * a, at * b, tolerance);
+}
+
 } //namespace vislib::util
\ No newline at end of file
@@ -1,43 +1,436 @@
 #pragma once
 
+#include <new>
+#include "types.hpp"
+#include "instrumentation.hpp"
+
 namespace vislib::util {
 
 template <typename T> constexpr T&& move(T& t) noexcept {
     return static_cast<T&&>(t);
 }
 
+template <typename T> struct RemoveReference { using type = T; };
+template <typename T> struct RemoveReference<T&> { using type = T; };
+template <typename T> struct RemoveReference<T&&> { using type = T; };
+
+template <typename T> struct RemoveConstImpl { using type = T; };
+template <typename T> struct RemoveConstImpl<const T> { using type = T; };
+
+template <typename T> using RemoveConst = typename RemoveConstImpl<T>::type;
+
+template <typename T> struct IsConst { static constexpr bool value = false; };
+template <typename T> struct IsConst<const T> { static constexpr bool value = true; };
+
+template <typename T, typename U> struct IsSame { static constexpr bool value = false; };
+template <typename T> struct IsSame<T, T> { static constexpr bool value = true; };
+
+// Wrapping a parameter type in TypeIdentity keeps it out of template argument deduction.
+template <typename T> struct TypeIdentityImpl { using type = T; };
+
+template <typename T> using TypeIdentity = typename TypeIdentityImpl<T>::type;
+
+template <bool CONDITION, typename T = void> struct EnableIfImpl {};
+template <typename T> struct EnableIfImpl<true, T> { using type = T; };
+
+template <bool CONDITION, typename T = void> using EnableIf = typename EnableIfImpl<CONDITION, T>::type;
+
+template <bool CONDITION, typename T, typename F> struct ConditionalImpl { using type = T; };
+template <typename T, typename F> struct ConditionalImpl<false, T, F> { using type = F; };
+
+template <bool CONDITION, typename T, typename F> using Conditional = typename ConditionalImpl<CONDITION, T, F>::type;
+
+template <typename... Ts> struct MakeVoid { using type = void; };
+
+template <typename... Ts> using VoidT = typename MakeVoid<Ts...>::type;
+
+// Only usable in unevaluated contexts such as decltype.
+template <typename T> T&& declval() noexcept;
+
+template <typename T> struct IsArithmetic { static constexpr bool value = false; };
+template <typename T> struct IsArithmetic<const T> : IsArithmetic<T> {};
+template <> struct IsArithmetic<bool> { static constexpr bool value = true; };
+template <> struct IsArithmetic<char> { static constexpr bool value = true; };
+template <> struct IsArithmetic<signed char> { static constexpr bool value = true; };
+template <> struct IsArithmetic<unsigned char> { static constexpr bool value = true; };
+template <> struct IsArithmetic<short> { static constexpr bool value = true; };
+template <> struct IsArithmetic<unsigned short> { static constexpr bool value = true; };
+template <> struct IsArithmetic<int> { static constexpr bool value = true; };
+template <> struct IsArithmetic<unsigned int> { static constexpr bool value = true; };
+template <> struct IsArithmetic<long> { static constexpr bool value = true; };
+template <> struct IsArithmetic<unsigned long> { static constexpr bool value = true; };
+template <> struct IsArithmetic<long long> { static constexpr bool value = true; };
+template <> struct IsArithmetic<unsigned long long> { static constexpr bool value = true; };
+template <> struct IsArithmetic<float> { static constexpr bool value = true; };
+template <> struct IsArithmetic<double> { static constexpr bool value = true; };
+template <> struct IsArithmetic<long double> { static constexpr bool value = true; };
+
+template <typename T> struct IsIntegral { static constexpr bool value = IsArithmetic<T>::value && static_cast<T>(0.5) == static_cast<T>(0); };
+template <typename T> struct IsIntegral<const T> : IsIntegral<T> {};
+
+template <typename T> constexpr T&& forward(typename RemoveReference<T>::type& t) noexcept {
+    return static_cast<T&&>(t);
+}
+
+template <typename T> constexpr T&& forward(typename RemoveReference<T>::type&& t) noexcept {
+    return static_cast<T&&>(t);
+}
+
+template <size_t... I> struct IndexSequence {};
+
+template <size_t N, size_t... I> struct MakeIndexSequenceImpl : MakeIndexSequenceImpl<N - 1, N - 1, I...> {};
+template <size_t... I> struct MakeIndexSequenceImpl<0, I...> { using type = IndexSequence<I...>; };
+
+template <size_t N> using MakeIndexSequence = typename MakeIndexSequenceImpl<N>::type;
+
 template <typename T> constexpr void swap(T& x, T& y) noexcept {
     T temp = move(x);
     x = move(y);
     y = move(temp);
 }
 
+constexpr size_t DEFAULT_ALIGNMENT = alignof(long double);
+
+constexpr size_t alignUp(size_t value, size_t alignment) noexcept {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+#ifndef VISLIB_CACHE_LINE_SIZE
+#define VISLIB_CACHE_LINE_SIZE 64
+#endif
+
+constexpr size_t CACHE_LINE_SIZE = VISLIB_CACHE_LINE_SIZE;
+
+// Acquire/release access to word sized values shared between two threads or a thread and an ISR.
+#if defined(__GNUC__) || defined(__clang__)
+
+template <typename T> inline T atomicLoadAcquire(const T *ptr) noexcept {
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+template <typename T> inline void atomicStoreRelease(T *ptr, T value) noexcept {
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+#else
+
+// MSVC gives volatile accesses acquire/release semantics by default (/volatile:ms).
+template <typename T> inline T atomicLoadAcquire(const T *ptr) noexcept {
+    return *static_cast<const volatile T*>(ptr);
+}
+
+template <typename T> inline void atomicStoreRelease(T *ptr, T value) noexcept {
+    *static_cast<volatile T*>(ptr) = value;
+}
+
+#endif
+
+// The only place the library takes memory from the global heap, which is what the instrumentation
+// allocation counters rely on. Alignments above what plain operator new guarantees go through the
+// aligned operator new, so deallocate has to be given the same alignment as allocate.
+class HeapAllocator {
+protected:
+    static bool overAligned(size_t alignment) noexcept {
+#ifdef __cpp_aligned_new
+        return alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+#else
+        (void)alignment;
+        return false;
+#endif
+    }
+
+public:
+    void* allocate(size_t bytes, size_t alignment = DEFAULT_ALIGNMENT) noexcept {
+        void *ptr = nullptr;
+#ifdef __cpp_aligned_new
+        if (overAligned(alignment)) {
+            ptr = ::operator new(bytes, std::align_val_t(alignment), std::nothrow);
+        } else {
+            ptr = ::operator new(bytes, std::nothrow);
+        }
+#else
+        (void)alignment;
+        ptr = ::operator new(bytes, std::nothrow);
+#endif
+        instrumentation::noteAllocation(ptr, bytes);
+        return ptr;
+    }
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment = DEFAULT_ALIGNMENT) noexcept {
+        instrumentation::noteDeallocation(ptr, bytes);
+#ifdef __cpp_aligned_new
+        if (overAligned(alignment)) {
+            ::operator delete(ptr, std::align_val_t(alignment));
+            return;
+        }
+#else
+        (void)alignment;
+#endif
+        ::operator delete(ptr);
+    }
+
+    template<typename T, typename... Args> T* create(Args&&... args) noexcept {
+        T *ptr = new (std::nothrow) T(util::forward<Args>(args)...);
+        instrumentation::noteAllocation(ptr, sizeof(T));
+        return ptr;
+    }
+
+    template<typename T> void destroy(T* ptr) noexcept {
+        instrumentation::noteDeallocation(ptr, sizeof(T));
+        delete ptr;
+    }
+
+    bool operator==(const HeapAllocator&) const noexcept {
+        return true;
+    }
+};
+
+class MonotonicArena {
+protected:
+    byte *buffer = nullptr;
+    size_t capacity = 0;
+    size_t offset = 0;
+    size_t highWater = 0;
+
+public:
+    MonotonicArena() = default;
+
+    MonotonicArena(void *p_buffer, size_t p_capacity) noexcept : buffer(static_cast<byte*>(p_buffer)), capacity(p_capacity) {}
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = DEFAULT_ALIGNMENT) noexcept {
+        size_t base = reinterpret_cast<size_t>(buffer);
+        size_t start = alignUp(base + offset, alignment) - base;
+        if (start > capacity || bytes > capacity - start) return nullptr;
+
+        offset = start + bytes;
+        if (offset > highWater) highWater = offset;
+        return buffer + start;
+    }
+
+    void deallocate(void *ptr, size_t bytes, size_t alignment = DEFAULT_ALIGNMENT) noexcept {
+        (void)alignment;
+        if (static_cast<byte*>(ptr) + bytes == buffer + offset) {
+            offset = static_cast<size_t>(static_cast<byte*>(ptr) - buffer);
+        }
+    }
+
+    size_t mark() const noexcept {
+        return offset;
+    }
+
+    void rewind(size_t marker) noexcept {
+        if (marker < offset) offset = marker;
+    }
+
+    void reset() noexcept {
+        offset = 0;
+    }
+
+    size_t used() const noexcept {
+        return offset;
+    }
+
+    size_t remaining() const noexcept {
+        return capacity - offset;
+    }
+
+    size_t Capacity() const noexcept {
+        return capacity;
+    }
+
+    size_t highWaterMark() const noexcept {
+        return highWater;
+    }
+};
+
+template<size_t SIZE> class StaticArena : public MonotonicArena {
+protected:
+    alignas(DEFAULT_ALIGNMENT) byte storage[SIZE];
+
+public:
+    StaticArena() noexcept : MonotonicArena(storage, SIZE) {}
+};
+
+class BlockPool {
+protected:
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    byte *buffer = nullptr;
+    size_t blockSize = 0;
+    size_t blockCount = 0;
+    size_t freeCount = 0;
+    FreeBlock *freeList = nullptr;
+
+public:
+    BlockPool() = default;
+
+    BlockPool(void *p_buffer, size_t bufferSize, size_t p_blockSize) noexcept
+    : buffer(static_cast<byte*>(p_buffer)), blockSize(alignUp(p_blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : p_blockSize, DEFAULT_ALIGNMENT)) {
+        size_t base = reinterpret_cast<size_t>(buffer);
+        size_t skip = alignUp(base, DEFAULT_ALIGNMENT) - base;
+        if (skip > bufferSize) return;
+
+        buffer += skip;
+        blockCount = (bufferSize - skip) / blockSize;
+
+        for (size_t i = blockCount; i > 0; i--) {
+            FreeBlock *block = reinterpret_cast<FreeBlock*>(buffer + (i - 1) * blockSize);
+            block->next = freeList;
+            freeList = block;
+        }
+        freeCount = blockCount;
+    }
+
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = DEFAULT_ALIGNMENT) noexcept {
+        if (bytes > blockSize || alignment > DEFAULT_ALIGNMENT || freeList == nullptr) return nullptr;
+
+        FreeBlock *block = freeList;
+        freeList = block->next;
+        freeCount--;
+        return block;
+    }
+
+    void deallocate(void *ptr, size_t bytes, size_t alignment = DEFAULT_ALIGNMENT) noexcept {
+        (void)bytes;
+        (void)alignment;
+        if (ptr == nullptr) return;
+
+        FreeBlock *block = static_cast<FreeBlock*>(ptr);
+        block->next = freeList;
+        freeList = block;
+        freeCount++;
+    }
+
+    size_t BlockSize() const noexcept {
+        return blockSize;
+    }
+
+    size_t BlockCount() const noexcept {
+        return blockCount;
+    }
+
+    size_t freeBlocks() const noexcept {
+        return freeCount;
+    }
+};
+
+template<size_t BLOCK_SIZE, size_t BLOCK_COUNT> class StaticPool : public BlockPool {
+protected:
+    alignas(DEFAULT_ALIGNMENT) byte storage[alignUp(BLOCK_SIZE, DEFAULT_ALIGNMENT) * BLOCK_COUNT];
+
+public:
+    StaticPool() noexcept : BlockPool(storage, sizeof(storage), BLOCK_SIZE) {}
+};
+
+template<typename Resource> class ResourceAllocator {
+protected:
+    Resource *resource = nullptr;
+
+public:
+    ResourceAllocator() = default;
+
+    ResourceAllocator(Resource& p_resource) noexcept : resource(&p_resource) {}
+
+    void* allocate(size_t bytes, size_t alignment = DEFAULT_ALIGNMENT) noexcept {
+        if (resource == nullptr) return nullptr;
+        return resource->allocate(bytes, alignment);
+    }
+
+    void deallocate(void *ptr, size_t bytes, size_t alignment = DEFAULT_ALIGNMENT) noexcept {
+        if (resource == nullptr || ptr == nullptr) return;
+        resource->deallocate(ptr, bytes, alignment);
+    }
+
+    template<typename T, typename... Args> T* create(Args&&... args) noexcept {
+        void *memory = allocate(sizeof(T), alignof(T));
+        if (memory == nullptr) return nullptr;
+        return new (memory) T(util::forward<Args>(args)...);
+    }
+
+    template<typename T> void destroy(T *ptr) noexcept {
+        if (ptr == nullptr) return;
+        ptr->~T();
+        deallocate(ptr, sizeof(T), alignof(T));
+    }
+
+    bool operator==(const ResourceAllocator& other) const noexcept {
+        return resource == other.resource;
+    }
+};
+
+using ArenaAllocator = ResourceAllocator<MonotonicArena>;
+using PoolAllocator = ResourceAllocator<BlockPool>;
+
 template <typename T> void deleter(T *ptr) noexcept {
     delete ptr;
 }
 
-template<typename T, void (*DELETER)(T*) = deleter> class UniquePtr {
+// With the default deleter the object is released through alloc.destroy, so it must come from
+// alloc. Raw pointers are only adopted where that holds for new T, on the heap allocator or with a
+// custom DELETER; objects of other allocators are adopted with UniquePtr::adopt.
+template<typename T, void (*DELETER)(T*) = deleter, typename Alloc = HeapAllocator> class UniquePtr {
 protected:
+    static constexpr bool DEFAULT_DELETER = DELETER == static_cast<void (*)(T*)>(deleter<T>);
+    static constexpr bool ADOPTS_NEW = IsSame<Alloc, HeapAllocator>::value || !DEFAULT_DELETER;
+
+    struct AdoptTag {};
+
     T *ptr = nullptr;
+    [[no_unique_address]] Alloc alloc;
+
+    void destroyPtr() noexcept {
+        if constexpr (DEFAULT_DELETER) {
+            alloc.destroy(ptr);
+        } else {
+            DELETER(ptr);
+        }
+    }
+
+    // A plain new T never passed the heap allocator, count it now so destroy balances the counters.
+    static T* adoptNew(T *p_ptr) noexcept {
+        if constexpr (DEFAULT_DELETER) {
+            if (p_ptr != nullptr) instrumentation::noteAllocation(p_ptr, sizeof(T));
+        }
+        return p_ptr;
+    }
+
+    UniquePtr(AdoptTag, T *p_ptr, const Alloc& p_alloc) noexcept : ptr(p_ptr), alloc(p_alloc) {}
 
 public:
     UniquePtr() = default;
 
-    UniquePtr(const T& v) noexcept {
-        ptr = new T(v);
+    explicit UniquePtr(const Alloc& p_alloc) noexcept : alloc(p_alloc) {}
+
+    UniquePtr(const T& v, const Alloc& p_alloc = Alloc()) noexcept : alloc(p_alloc) {
+        ptr = alloc.template create<T>(v);
     }
 
-    UniquePtr(T *p_ptr) : ptr(p_ptr) {}
+    // Adopts p_ptr from new T, or anything DELETER can free.
+    template<bool ENABLED = ADOPTS_NEW, typename = EnableIf<ENABLED>> UniquePtr(T *p_ptr, const Alloc& p_alloc = Alloc()) noexcept
+    : ptr(adoptNew(p_ptr)), alloc(p_alloc) {}
+
+    // Adopts p_ptr created by p_alloc.create<T>, e.g. one released from another UniquePtr of p_alloc.
+    static UniquePtr adopt(T *p_ptr, const Alloc& p_alloc) noexcept {
+        return UniquePtr(AdoptTag(), p_ptr, p_alloc);
+    }
 
     UniquePtr(const UniquePtr&) = delete;
 
-    UniquePtr(UniquePtr&& other) noexcept {
+    UniquePtr(UniquePtr&& other) noexcept : alloc(other.alloc) {
         ptr = other.ptr;
         other.ptr = nullptr;
     }
 
     ~UniquePtr() noexcept {
-        DELETER(ptr);
+        destroyPtr();
     }
 
     T& operator*() const noexcept {
@@ -52,18 +445,20 @@ public:
         return ptr != nullptr;
     }
 
-    UniquePtr<T>& operator=(const UniquePtr&) = delete;
+    UniquePtr& operator=(const UniquePtr&) = delete;
 
-    UniquePtr<T>& operator=(UniquePtr&& other) noexcept {
-        DELETER(ptr);
+    UniquePtr& operator=(UniquePtr&& other) noexcept {
+        if (this == &other) return *this;
+        destroyPtr();
         ptr = other.ptr;
+        alloc = other.alloc;
         other.ptr = nullptr;
         return *this;
     }
 
-    UniquePtr<T>& operator=(const T& v) noexcept {
+    UniquePtr& operator=(const T& v) noexcept {
         if(ptr == nullptr) {
-            ptr = new T(v);
+            ptr = alloc.template create<T>(v);
         } else {
             *ptr = v;
         }
@@ -80,11 +475,30 @@ public:
         return temp;
     }
 
-    void reset(T *new_ptr = nullptr) noexcept {
-        DELETER(ptr);
-        ptr = new_ptr;
+    void reset() noexcept {
+        destroyPtr();
+        ptr = nullptr;
+    }
+
+    void reset(decltype(nullptr)) noexcept {
+        reset();
+    }
+
+    template<bool ENABLED = ADOPTS_NEW, typename = EnableIf<ENABLED>> void reset(T *new_ptr) noexcept {
+        destroyPtr();
+        ptr = adoptNew(new_ptr);
+    }
+
+    const Alloc& Allocator() const noexcept {
+        return alloc;
     }
 
 };
 
+template<typename T, typename Alloc, typename... Args> UniquePtr<T, deleter, Alloc> allocateUnique(const Alloc& alloc, Args&&... args) noexcept {
+    Alloc a = alloc;
+    T *ptr = a.template create<T>(util::forward<Args>(args)...);
+    return UniquePtr<T, deleter, Alloc>::adopt(ptr, a);
+}
+
 } //namespace vislib::util
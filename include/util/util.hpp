@@ -3,7 +3,10 @@
 #include "types.hpp"
 #include "errordef.hpp"
 #include "errors.hpp"
+#include "format.hpp"
+#include "instrumentation.hpp"
 #include "math.hpp"
+#include "fixed.hpp"
 
 namespace vislib::util {
 